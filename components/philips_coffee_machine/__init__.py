@@ -3,6 +3,7 @@ import esphome.config_validation as cv
 from esphome import pins
 from esphome.components.uart import UARTComponent
 from esphome.const import CONF_ID
+from esphome.core import CORE
 
 DEPENDENCIES = ["uart"]
 
@@ -14,6 +15,13 @@ INVERT_POWER_PIN = "invert_power_pin"
 POWER_TRIP_DELAY = "power_trip_delay"
 DISPLAY_BOOT_DELAY = "display_boot_delay"
 CONF_POWER_MESSAGE_REPETITIONS = "power_message_repetitions"
+CONF_FLUSH_UARTS = "flush_uarts"
+CONF_BRIDGE_TASK = "bridge_task"
+CONF_STATUS_REQUEST_INTERVAL = "status_request_interval"
+CONF_SETTLE_TIME = "settle_time"
+CONF_SETTLE_TIME_ERROR = "error"
+CONF_SETTLE_TIME_STEADY = "steady"
+CONF_SETTLE_TIME_SELECTION = "selection"
 
 CONF_COMMAND_SET = "model"
 COMMAND_SETS = {
@@ -38,6 +46,25 @@ philips_coffee_machine_ns = cg.esphome_ns.namespace("philips_coffee_machine")
 PhilipsCoffeeMachine = philips_coffee_machine_ns.class_(
     "PhilipsCoffeeMachine", cg.Component
 )
+StateClass = philips_coffee_machine_ns.enum("StateClass")
+STATE_CLASSES = {
+    CONF_SETTLE_TIME_ERROR: StateClass.STATE_CLASS_ERROR,
+    CONF_SETTLE_TIME_STEADY: StateClass.STATE_CLASS_STEADY,
+    CONF_SETTLE_TIME_SELECTION: StateClass.STATE_CLASS_SELECTION,
+}
+
+SETTLE_TIME_RANGE = cv.All(
+    cv.positive_time_period_milliseconds,
+    cv.Range(max=cv.TimePeriod(milliseconds=10000)),
+)
+
+
+def validate_bridge_task(value):
+    value = cv.boolean(value)
+    if value and not (CORE.is_esp32 or CORE.is_host):
+        raise cv.Invalid("The bridge task is only supported on the ESP32")
+    return value
+
 
 CONFIG_SCHEMA = cv.Schema(
     {
@@ -60,7 +87,28 @@ CONFIG_SCHEMA = cv.Schema(
                 max_included=cv.TimePeriod(milliseconds=15000),
             ),
         ),
-        cv.Optional(CONF_POWER_MESSAGE_REPETITIONS, default=5): cv.positive_int,
+        # Sent as a single queue entry, the frame count (repetitions + 1) has to fit into 16 bits
+        cv.Optional(CONF_POWER_MESSAGE_REPETITIONS, default=5): cv.int_range(
+            min=0, max=65534
+        ),
+        cv.Optional(CONF_FLUSH_UARTS, default=False): cv.boolean,
+        cv.Optional(CONF_BRIDGE_TASK, default=False): validate_bridge_task,
+        cv.Optional(CONF_STATUS_REQUEST_INTERVAL): cv.All(
+            cv.positive_time_period_milliseconds,
+            cv.Range(
+                min=cv.TimePeriod(milliseconds=20),
+                max_included=cv.TimePeriod(milliseconds=1000),
+            ),
+        ),
+        cv.Optional(CONF_SETTLE_TIME, default={}): cv.Schema(
+            {
+                cv.Optional(CONF_SETTLE_TIME_ERROR, default="100ms"): SETTLE_TIME_RANGE,
+                cv.Optional(CONF_SETTLE_TIME_STEADY, default="300ms"): SETTLE_TIME_RANGE,
+                cv.Optional(
+                    CONF_SETTLE_TIME_SELECTION, default="750ms"
+                ): SETTLE_TIME_RANGE,
+            }
+        ),
         cv.Optional(CONF_COMMAND_SET, default="EP_2220"): cv.enum(
             COMMAND_SETS, upper=True, space="_"
         ),
@@ -88,3 +136,11 @@ async def to_code(config):
     cg.add(var.set_invert_power_pin(config[INVERT_POWER_PIN]))
     cg.add(var.set_power_trip_delay(config[POWER_TRIP_DELAY]))
     cg.add(var.set_display_boot_delay(config[DISPLAY_BOOT_DELAY]))
+    cg.add(var.set_flush_uarts(config[CONF_FLUSH_UARTS]))
+    cg.add(var.set_bridge_task(config[CONF_BRIDGE_TASK]))
+    if CONF_STATUS_REQUEST_INTERVAL in config:
+        cg.add(
+            var.set_status_request_interval(config[CONF_STATUS_REQUEST_INTERVAL])
+        )
+    for key, state_class in STATE_CLASSES.items():
+        cg.add(var.set_settle_time(state_class, config[CONF_SETTLE_TIME][key]))
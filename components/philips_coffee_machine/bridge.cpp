@@ -0,0 +1,173 @@
+#include <algorithm>
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "bridge.h"
+#include "checksum.h"
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        static constexpr std::size_t MAINBOARD_BUFFER_SIZE = MAINBOARD_FRAME_SIZE;
+        static constexpr std::size_t DISPLAY_BUFFER_SIZE = DISPLAY_FRAME_SIZE;
+
+        static const char *const TAG = "philips_bridge";
+
+        void Bridge::poll()
+        {
+            uint8_t display_buffer[DISPLAY_BUFFER_SIZE];
+            uint8_t mainboard_buffer[MAINBOARD_BUFFER_SIZE];
+            uint32_t now = millis();
+            bool answer_from_cache = use_cache(now);
+            bool emulating_display = bus_->is_emulating_display();
+
+            // Frames injected by the component loop are written here, display messages are only forwarded as a whole
+            bus_->write_deferred_frames();
+
+            // Pipe display to mainboard, the bus arbiter forwards whole messages unless the bus has been acquired
+            while (display_uart_->available())
+            {
+                std::size_t size = std::min<std::size_t>(display_uart_->available(), DISPLAY_BUFFER_SIZE);
+                display_uart_->read_array(display_buffer, size);
+
+                std::size_t requests;
+                std::size_t dropped = bus_->forward_display_bytes(display_buffer, size, requests);
+                if (answer_from_cache)
+                    pending_cached_replies_ += dropped;
+                if (requests > 0)
+                    display_reply_pending_ = true;
+                last_display_time_.store(millis(), std::memory_order_release);
+            }
+
+            // Pipe to display and reassemble mainboard messages
+            while (mainboard_uart_->available())
+            {
+                std::size_t size = std::min<std::size_t>(mainboard_uart_->available(), MAINBOARD_BUFFER_SIZE);
+                mainboard_uart_->read_array(mainboard_buffer, size);
+
+                // Whether a message reaches the display is decided at its start, the buffer is compacted in place
+                std::size_t forwarded = 0;
+                for (std::size_t i = 0; i < size; i++)
+                {
+                    uint8_t byte = mainboard_buffer[i];
+                    // While the display is emulated only a single reply per display request is forwarded
+                    if (!mainboard_frame_reader_.in_frame())
+                        forward_mainboard_frame_ = !answer_from_cache && (!emulating_display || display_reply_pending_);
+                    if (forward_mainboard_frame_)
+                        mainboard_buffer[forwarded++] = byte;
+
+                    if (!mainboard_frame_reader_.push(byte))
+                        continue;
+
+                    if (forward_mainboard_frame_)
+                        display_reply_pending_ = false;
+
+                    MainboardFrame frame;
+                    std::copy(mainboard_frame_reader_.data(), mainboard_frame_reader_.data() + MAINBOARD_FRAME_SIZE, frame.begin());
+                    if (!frames_.push(frame))
+                        dropped_frames_.store(dropped_frames_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+                    // Replies to injected messages are not cached, the display did not request them
+                    if (!bus_->is_acquired() && is_valid_frame(frame.data(), MAINBOARD_FRAME_SIZE))
+                    {
+                        cached_frame_ = frame;
+                        cached_frame_time_ = now;
+                        has_cached_frame_ = true;
+                    }
+                }
+
+                if (forwarded > 0)
+                {
+                    display_uart_->write_array(mainboard_buffer, forwarded);
+                    display_tx_pending_.store(true, std::memory_order_release);
+                }
+            }
+
+            // Answer dropped display requests, but never in the middle of a forwarded mainboard message
+            if (!answer_from_cache)
+            {
+                pending_cached_replies_ = 0;
+            }
+            else if (pending_cached_replies_ > 0 && !(forward_mainboard_frame_ && mainboard_frame_reader_.in_frame()))
+            {
+                for (; pending_cached_replies_ > 0; pending_cached_replies_--)
+                {
+                    display_uart_->write_array(cached_frame_.data(), MAINBOARD_FRAME_SIZE);
+                    cached_replies_.store(cached_replies_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                }
+                display_tx_pending_.store(true, std::memory_order_release);
+            }
+        }
+
+        void Bridge::task_main(void *arg)
+        {
+            Bridge *bridge = static_cast<Bridge *>(arg);
+            while (bridge->running_.load(std::memory_order_acquire))
+            {
+                bridge->poll();
+#ifdef USE_ESP32
+                vTaskDelay(pdMS_TO_TICKS(BRIDGE_TASK_INTERVAL) > 0 ? pdMS_TO_TICKS(BRIDGE_TASK_INTERVAL) : 1);
+#elif defined(USE_HOST)
+                std::this_thread::sleep_for(std::chrono::milliseconds(BRIDGE_TASK_INTERVAL));
+#endif
+            }
+
+#ifdef USE_ESP32
+            bridge->task_active_.store(false, std::memory_order_release);
+            vTaskDelete(nullptr);
+#endif
+        }
+
+        bool Bridge::start_task()
+        {
+            if (is_task_running())
+                return true;
+
+            running_.store(true, std::memory_order_release);
+#ifdef USE_ESP32
+            // Only the task writes to the mainboard uart while it is running
+            bus_->set_deferred_transmission(true);
+            task_active_.store(true, std::memory_order_release);
+            if (xTaskCreatePinnedToCore(task_main, "philips_bridge", BRIDGE_TASK_STACK_SIZE, this,
+                                        BRIDGE_TASK_PRIORITY, nullptr, BRIDGE_TASK_CORE) != pdPASS)
+            {
+                ESP_LOGE(TAG, "Failed to create bridge task");
+                task_active_.store(false, std::memory_order_release);
+                running_.store(false, std::memory_order_release);
+                bus_->set_deferred_transmission(false);
+                return false;
+            }
+            return true;
+#elif defined(USE_HOST)
+            bus_->set_deferred_transmission(true);
+            thread_ = std::thread(task_main, this);
+            return true;
+#else
+            ESP_LOGW(TAG, "Bridge task is not supported on this platform");
+            running_.store(false, std::memory_order_release);
+            return false;
+#endif
+        }
+
+        void Bridge::stop_task()
+        {
+            running_.store(false, std::memory_order_release);
+#ifdef USE_ESP32
+            while (task_active_.load(std::memory_order_acquire))
+                vTaskDelay(1);
+#elif defined(USE_HOST)
+            if (thread_.joinable())
+                thread_.join();
+#endif
+
+            // Frames the task did not write anymore are written by the component loop from now on
+            if (bus_ != nullptr)
+            {
+                bus_->set_deferred_transmission(false);
+                bus_->write_deferred_frames();
+            }
+        }
+
+    } // namespace philips_coffee_machine
+} // namespace esphome
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include "esphome/components/uart/uart.h"
+#include "bus_arbiter.h"
+#include "commands.h"
+#include "frame_reader.h"
+#include "spsc_ring.h"
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#elif defined(USE_HOST)
+#include <thread>
+#endif
+
+#define FRAME_RING_SIZE 8
+#define BRIDGE_TASK_STACK_SIZE 4096
+#define BRIDGE_TASK_PRIORITY 5
+#define BRIDGE_TASK_CORE 0
+#define BRIDGE_TASK_INTERVAL 1
+// Longest time a cached mainboard message is used to answer the display, longer than a long press
+#define FRAME_CACHE_MAX_AGE 5000
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        /// @brief A complete message sent by the mainboard
+        using MainboardFrame = std::array<uint8_t, MAINBOARD_FRAME_SIZE>;
+
+        /**
+         * @brief Forwards bytes between display and mainboard.
+         * Complete mainboard messages are handed to the component loop through a lock-free ring, thus the forwarding
+         * can either be polled from the component loop or run in a dedicated task (FreeRTOS on the ESP32, a thread on the host platform).
+         * The frames injected by the bus arbiter are handed the other way, so the task is the only writer of the mainboard uart.
+         *
+         * The last valid mainboard message is cached. While the bus is acquired the display requests are dropped, thus every
+         * dropped request is answered with the cached message instead and the mainboard replies to injected messages are
+         * withheld. The display keeps receiving one message per request and never notices the injection.
+         * Messages are only withheld or replaced as a whole, a cache older than FRAME_CACHE_MAX_AGE falls back to plain forwarding.
+         *
+         * While the display is emulated the mainboard also answers the status requests of the controller. Only the first
+         * mainboard message after each display request is forwarded then, the replies to the emulated requests are withheld.
+         */
+        class Bridge
+        {
+        public:
+            ~Bridge()
+            {
+                stop_task();
+            }
+
+            /**
+             * @brief Sets the uarts and the arbiter of the mainboard bus
+             *
+             * @param display uart connected to the display
+             * @param mainboard uart connected to the mainboard
+             * @param bus arbiter owning the transmitting side of the mainboard uart
+             */
+            void setup(uart::UARTDevice *display, uart::UARTDevice *mainboard, BusArbiter *bus)
+            {
+                display_uart_ = display;
+                mainboard_uart_ = mainboard;
+                bus_ = bus;
+            }
+
+            /**
+             * @brief Forwards all bytes which are currently available on both uarts.
+             * Must only be called from a single context (the component loop or the bridge task).
+             */
+            void poll();
+
+            /**
+             * @brief Starts the dedicated bridge task which calls poll() every BRIDGE_TASK_INTERVAL ms
+             *
+             * @return false if tasks are not supported on this platform or the task could not be created
+             */
+            bool start_task();
+
+            /**
+             * @brief Stops the bridge task and waits for it to exit
+             */
+            void stop_task();
+
+            /**
+             * @brief Determines if the dedicated bridge task is running
+             */
+            bool is_task_running() const
+            {
+                return running_.load(std::memory_order_acquire);
+            }
+
+            /**
+             * @brief Takes the oldest complete mainboard message
+             *
+             * @param frame receives the message
+             * @return false if no message is available
+             */
+            bool pop_frame(MainboardFrame &frame)
+            {
+                return frames_.pop(frame);
+            }
+
+            /**
+             * @brief Time at which the last bytes have been received from the display
+             */
+            uint32_t last_display_time() const
+            {
+                return last_display_time_.load(std::memory_order_acquire);
+            }
+
+            /**
+             * @brief Determines if anything has been written to the display since the last call and resets the flag
+             */
+            bool take_display_tx_pending()
+            {
+                return take_flag(display_tx_pending_);
+            }
+
+            /**
+             * @brief Number of display requests which have been answered with the cached mainboard message
+             */
+            uint32_t cached_replies() const
+            {
+                return cached_replies_.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Number of mainboard messages dropped because the ring was full
+             */
+            uint32_t dropped_frames() const
+            {
+                return dropped_frames_.load(std::memory_order_relaxed);
+            }
+
+        private:
+            /**
+             * @brief Entry point of the bridge task
+             *
+             * @param arg bridge instance
+             */
+            static void task_main(void *arg);
+
+            /**
+             * @brief Determines if dropped display requests should be answered from the cache
+             *
+             * @param now current time
+             */
+            bool use_cache(uint32_t now) const
+            {
+                return bus_->is_acquired() && has_cached_frame_ && now - cached_frame_time_ <= FRAME_CACHE_MAX_AGE;
+            }
+
+            /// @brief reference to uart connected to the display unit
+            uart::UARTDevice *display_uart_ = nullptr;
+
+            /// @brief reference to uart connected to the mainboard
+            uart::UARTDevice *mainboard_uart_ = nullptr;
+
+            /// @brief arbiter of the mainboard bus
+            BusArbiter *bus_ = nullptr;
+
+            /// @brief reassembles mainboard messages, only used by the polling context
+            FrameReader<MAINBOARD_FRAME_SIZE> mainboard_frame_reader_;
+
+            /// @brief last valid mainboard message received while the bus was not acquired, only used by the polling context
+            MainboardFrame cached_frame_ = {};
+
+            /// @brief time at which the cached message has been received
+            uint32_t cached_frame_time_ = 0;
+
+            /// @brief true once a message has been cached
+            bool has_cached_frame_ = false;
+
+            /// @brief number of display requests which still have to be answered from the cache
+            std::size_t pending_cached_replies_ = 0;
+
+            /// @brief true if the mainboard message currently being received is forwarded to the display
+            bool forward_mainboard_frame_ = true;
+
+            /// @brief true if a display request has been forwarded which has not been answered yet
+            bool display_reply_pending_ = false;
+
+            /// @brief complete mainboard messages waiting for the component loop
+            SpscRing<MainboardFrame, FRAME_RING_SIZE> frames_;
+
+            /// @brief time at which the last bytes have been received from the display
+            std::atomic<uint32_t> last_display_time_{0};
+
+            /// @brief true if bytes have been written to the display since the last take_display_tx_pending()
+            std::atomic<bool> display_tx_pending_{false};
+
+            /// @brief number of display requests answered from the cache, only written by the polling context
+            std::atomic<uint32_t> cached_replies_{0};
+
+            /// @brief number of mainboard messages dropped due to a full ring, only written by the polling context
+            std::atomic<uint32_t> dropped_frames_{0};
+
+            /// @brief true while the bridge task should keep running
+            std::atomic<bool> running_{false};
+
+#ifdef USE_ESP32
+            /// @brief true until the bridge task has left its loop
+            std::atomic<bool> task_active_{false};
+#elif defined(USE_HOST)
+            /// @brief thread standing in for the bridge task
+            std::thread thread_;
+#endif
+        };
+
+    } // namespace philips_coffee_machine
+} // namespace esphome
@@ -0,0 +1,223 @@
+#include <algorithm>
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "bus_arbiter.h"
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        static const char *const TAG = "philips_bus_arbiter";
+
+        std::size_t BusArbiter::forward_display_bytes(const uint8_t *data, std::size_t length, std::size_t &forwarded)
+        {
+            std::size_t dropped = 0;
+            forwarded = 0;
+            for (std::size_t i = 0; i < length; i++)
+            {
+                if (!display_frame_reader_.push(data[i]))
+                    continue;
+
+                last_display_frame_time_.store(millis(), std::memory_order_release);
+
+                // Block messages during automated sequences
+                if (!is_acquired())
+                {
+                    mainboard_uart_->write_array(display_frame_reader_.data(), DISPLAY_FRAME_SIZE);
+                    tx_pending_.store(true, std::memory_order_release);
+                    forwarded++;
+                }
+                else
+                {
+                    dropped++;
+                }
+            }
+            return dropped;
+        }
+
+        bool BusArbiter::enqueue(const Command &command, TxPriority priority, uint16_t repetitions, uint16_t gap, uint16_t ack_leds)
+        {
+            TxQueue &queue = queues_[priority];
+            if (queue.count == TX_QUEUE_SIZE)
+            {
+                dropped_count_++;
+                ESP_LOGW(TAG, "TX queue %d full, dropping message", priority);
+                return false;
+            }
+
+            TxEntry &entry = queue.entries[(queue.head + queue.count) % TX_QUEUE_SIZE];
+            entry.command = command;
+            // Power messages keep their configured repetitions, some displays need far more frames than a button press
+            entry.remaining = ack_leds != 0 && priority != TX_PRIORITY_POWER ? ack_frame_limit(repetitions + 1) : repetitions + 1;
+            entry.gap = gap;
+            entry.ack_leds = ack_leds;
+            entry.sent = 0;
+            queue.count++;
+            return true;
+        }
+
+        void BusArbiter::loop()
+        {
+            for (uint8_t sent = 0; sent < TX_FRAMES_PER_LOOP;)
+            {
+                // A message awaiting its acknowledgement keeps the bus, otherwise find the highest priority message
+                TxQueue *queue = ack_queue_;
+                for (TxQueue &candidate : queues_)
+                {
+                    if (queue != nullptr)
+                        break;
+                    if (candidate.count > 0)
+                        queue = &candidate;
+                }
+                if (queue == nullptr)
+                {
+                    // Poll the mainboard like the display does, but never interfere with entities holding the bus
+                    if (is_emulating_display() && !is_acquired() && millis() - last_transmission_ >= status_request_interval_)
+                        transmit(command_status_request);
+                    return;
+                }
+
+                TxEntry &entry = queue->entries[queue->head];
+                if (queue == ack_queue_)
+                {
+                    // Give the mainboard the chance to react before repeating
+                    if (frames_since_transmission_ < ACK_RESPONSE_FRAMES && millis() - last_transmission_ < ACK_TIMEOUT)
+                        return;
+
+                    if (entry.remaining == 0)
+                    {
+                        finish_acknowledgement(false);
+                        continue;
+                    }
+                }
+
+                // Lower priorities have to wait as well, otherwise sequences could be reordered
+                if (millis() - last_transmission_ < entry.gap)
+                    return;
+
+                // The bridge task has not caught up yet, the frame is sent during the next iteration
+                if (!transmit(entry.command))
+                    return;
+                entry.gap = 0;
+                entry.sent++;
+                entry.remaining--;
+                sent++;
+
+                if (entry.ack_leds != 0)
+                {
+                    // Led changes are compared to the state before the first frame
+                    if (ack_queue_ == nullptr)
+                    {
+                        ack_queue_ = queue;
+                        ack_leds_ = last_leds_;
+                    }
+                    frames_since_transmission_ = 0;
+                    return;
+                }
+
+                if (entry.remaining == 0)
+                {
+                    queue->head = (queue->head + 1) % TX_QUEUE_SIZE;
+                    queue->count--;
+                }
+            }
+        }
+
+        bool BusArbiter::transmit(const Command &command)
+        {
+            if (deferred_transmission_)
+            {
+                if (!deferred_frames_.push(command))
+                    return false;
+            }
+            else
+            {
+                mainboard_uart_->write_array(command);
+                tx_pending_.store(true, std::memory_order_release);
+            }
+            last_transmission_ = millis();
+            return true;
+        }
+
+        void BusArbiter::write_deferred_frames()
+        {
+            Command command;
+            while (deferred_frames_.pop(command))
+            {
+                mainboard_uart_->write_array(command);
+                tx_pending_.store(true, std::memory_order_release);
+            }
+        }
+
+        void BusArbiter::update_acknowledgement(const MachineSnapshot &snapshot)
+        {
+            if (ack_queue_ != nullptr)
+            {
+                if (frames_since_transmission_ < UINT8_MAX)
+                    frames_since_transmission_++;
+
+                uint16_t expected = ack_queue_->entries[ack_queue_->head].ack_leds;
+                for (std::size_t i = 0; i < LED_COUNT; i++)
+                {
+                    // Unrelated leds (i.e. warnings) and leds with a blink period change on their own
+                    if ((expected & (1 << i)) != 0 && snapshot.leds[i] != ack_leds_[i] && snapshot.blink_period[i] == 0)
+                    {
+                        finish_acknowledgement(true);
+                        break;
+                    }
+                }
+            }
+
+            last_leds_ = snapshot.leds;
+        }
+
+        void BusArbiter::finish_acknowledgement(bool acknowledged)
+        {
+            const TxEntry &entry = ack_queue_->entries[ack_queue_->head];
+            // Only the messages which are limited by the mean are used to learn it
+            bool adaptive = ack_queue_ != &queues_[TX_PRIORITY_POWER];
+            if (acknowledged)
+            {
+                ack_delivered_++;
+                ack_frames_sum_ += entry.sent;
+                if (adaptive)
+                {
+                    ack_learned_++;
+                    ack_mean_ = ack_learned_ == 1 ? entry.sent : ack_mean_ + (entry.sent - ack_mean_) / 8;
+                }
+            }
+            else
+            {
+                // Allow more frames for the next messages
+                ack_failed_++;
+                if (adaptive)
+                    ack_mean_ += 1;
+                ESP_LOGD(TAG, "Message not acknowledged after %d frames", entry.sent);
+            }
+
+            ack_queue_->head = (ack_queue_->head + 1) % TX_QUEUE_SIZE;
+            ack_queue_->count--;
+            ack_queue_ = nullptr;
+        }
+
+        uint16_t BusArbiter::ack_frame_limit(uint16_t frames) const
+        {
+            // Until a message has been confirmed the requested frames are used
+            if (ack_learned_ == 0)
+                return frames;
+
+            uint16_t limit = (uint16_t) std::lround(ack_mean_) + ACK_FRAME_MARGIN;
+            return std::min(frames, limit);
+        }
+
+        std::size_t BusArbiter::queue_depth() const
+        {
+            std::size_t depth = 0;
+            for (const TxQueue &queue : queues_)
+                depth += queue.count;
+            return depth;
+        }
+
+    } // namespace philips_coffee_machine
+} // namespace esphome
@@ -0,0 +1,347 @@
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include "esphome/components/uart/uart.h"
+#include "commands.h"
+#include "frame_reader.h"
+#include "machine_snapshot.h"
+#include "spsc_ring.h"
+
+#define TX_QUEUE_SIZE 8
+// Frames handed to the bridge task, must be a power of two
+#define TX_RING_SIZE 8
+#define TX_FRAMES_PER_LOOP 4
+// Number of mainboard messages after which an unacknowledged message is repeated
+#define ACK_RESPONSE_FRAMES 2
+// Time after which an unacknowledged message is repeated even if the mainboard did not respond
+#define ACK_TIMEOUT 150
+// Additional frames allowed on top of the mean number of frames acknowledged messages needed
+#define ACK_FRAME_MARGIN 2
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        /**
+         * @brief Reads and clears a flag which may be set by the bridge task at any time
+         *
+         * @param flag flag to take
+         * @return true if the flag has been set
+         */
+        inline bool take_flag(std::atomic<bool> &flag)
+        {
+#if defined(USE_ESP32) || defined(USE_HOST)
+            return flag.exchange(false, std::memory_order_acq_rel);
+#else
+            // Read-modify-write atomics are not available on every platform. Those platforms do not support the
+            // bridge task, the flag is only set and taken by the component loop.
+            bool pending = flag.load(std::memory_order_acquire);
+            if (pending)
+                flag.store(false, std::memory_order_release);
+            return pending;
+#endif
+        }
+
+        /**
+         * @brief Priorities of queued messages, lower values are sent first
+         */
+        enum TxPriority : uint8_t
+        {
+            TX_PRIORITY_POWER = 0,
+            TX_PRIORITY_ACTION,
+            TX_PRIORITY_SETTING,
+            TX_PRIORITY_COUNT,
+        };
+
+        /**
+         * @brief Owns the transmitting side of the mainboard uart.
+         * Messages from the display are reassembled and forwarded as whole frames, thus messages injected by
+         * entities always end up between two display messages instead of tearing one apart.
+         * Entities which need the bus for themselves (i.e. long presses) acquire it instead of exposing flags.
+         *
+         * Messages of entities are queued in fixed size per-priority rings and drained from loop(), a few frames
+         * per iteration. This keeps every write within the uart's hardware FIFO, so the main loop never blocks on a burst.
+         *
+         * If the bridge runs in its own task forward_display_bytes() is called from that task while everything else
+         * is called from the component loop. The frames sent by loop() are then handed to the task through a ring and
+         * written by write_deferred_frames(), so the mainboard uart is only written by the task and an injected frame can
+         * never end up within a forwarded one.
+         *
+         * Optionally the arbiter emulates the display's polling: whenever nothing is queued and the bus is not acquired,
+         * a status request is sent once the status request interval has passed since the last injected message.
+         * This works without a display as well as in addition to the display's own status requests.
+         */
+        class BusArbiter
+        {
+        public:
+            /**
+             * @brief Sets the uart connected to the mainboard
+             *
+             * @param uart mainboard uart reference
+             */
+            void set_mainboard_uart(uart::UARTDevice *uart)
+            {
+                mainboard_uart_ = uart;
+            }
+
+            /**
+             * @brief Sets the interval in which status requests are sent to the mainboard
+             *
+             * @param interval time in ms, 0 disables the display emulation
+             */
+            void set_status_request_interval(uint32_t interval)
+            {
+                status_request_interval_ = interval;
+            }
+
+            /**
+             * @brief Hands the frames sent by loop() to the bridge task instead of writing them
+             *
+             * @param deferred true while the bridge task is running
+             */
+            void set_deferred_transmission(bool deferred)
+            {
+                deferred_transmission_ = deferred;
+            }
+
+            /**
+             * @brief Writes the frames which loop() has handed to the bridge task.
+             * Must be called from the context which calls forward_display_bytes(), between two of its calls.
+             */
+            void write_deferred_frames();
+
+            /**
+             * @brief Determines if status requests are sent in place of, or in addition to, the display
+             */
+            bool is_emulating_display() const
+            {
+                return status_request_interval_ > 0;
+            }
+
+            /**
+             * @brief Feeds bytes received from the display.
+             * Completed display messages are forwarded to the mainboard unless the bus has been acquired.
+             * Bytes which are not part of a message are dropped.
+             *
+             * @param data received bytes
+             * @param length number of received bytes
+             * @param forwarded receives the number of completed display messages which have been forwarded
+             * @return number of completed display messages which have been dropped because the bus is acquired
+             */
+            std::size_t forward_display_bytes(const uint8_t *data, std::size_t length, std::size_t &forwarded);
+
+            /**
+             * @brief Queues a message for the mainboard. Returns immediately, the message is sent from loop().
+             * Since display messages are only forwarded as a whole, it is always placed at a message boundary.
+             *
+             * @param command message to send
+             * @param priority queue to use
+             * @param repetitions number of additional repetitions
+             * @param gap time in ms which has to pass after the previous message before this one is started
+             * @param ack_leds leds the message is expected to change (led_bit()), repetitions stop as soon as one of them changes.
+             * 0 sends all repetitions.
+             * @return false if the queue was full and the message has been dropped
+             */
+            bool enqueue(const Command &command, TxPriority priority, uint16_t repetitions = 0, uint16_t gap = 0, uint16_t ack_leds = 0);
+
+            /**
+             * @brief Checks a decoded mainboard message for the acknowledgement of the message in flight.
+             * Only the leds expected to change are considered, those blinking on their own are ignored.
+             *
+             * @param snapshot decoded mainboard message
+             */
+            void update_acknowledgement(const MachineSnapshot &snapshot);
+
+            /**
+             * @brief Sends up to TX_FRAMES_PER_LOOP queued frames, highest priority first.
+             * If nothing is queued a status request is sent when the display emulation is due.
+             */
+            void loop();
+
+            /**
+             * @brief Determines if anything has been written since the last call and resets the flag
+             */
+            bool take_tx_pending()
+            {
+                return take_flag(tx_pending_);
+            }
+
+            /**
+             * @brief Number of messages currently waiting in all queues
+             */
+            std::size_t queue_depth() const;
+
+            /**
+             * @brief Number of messages dropped because their queue was full
+             */
+            uint32_t dropped_count() const
+            {
+                return dropped_count_;
+            }
+
+            /**
+             * @brief Percentage of acknowledged messages which have been confirmed by the mainboard
+             *
+             * @return success rate, NAN if no acknowledged message has been sent yet
+             */
+            float ack_success_rate() const
+            {
+                uint32_t total = ack_delivered_ + ack_failed_;
+                return total == 0 ? NAN : 100.0f * ack_delivered_ / total;
+            }
+
+            /**
+             * @brief Mean number of frames acknowledged messages needed until they have been confirmed
+             *
+             * @return mean frames, NAN if no message has been confirmed yet
+             */
+            float ack_mean_frames() const
+            {
+                return ack_delivered_ == 0 ? NAN : ack_frames_sum_ / (float) ack_delivered_;
+            }
+
+            /**
+             * @brief Time at which the last complete display message has been received, even if it has not been forwarded
+             */
+            uint32_t last_display_frame_time() const
+            {
+                return last_display_frame_time_.load(std::memory_order_acquire);
+            }
+
+            /**
+             * @brief Takes over the bus. Display messages are dropped until every acquire has been released.
+             */
+            void acquire()
+            {
+                // Only the component loop modifies the count, the bridge task merely reads it
+                hold_count_.store(hold_count_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            }
+
+            /**
+             * @brief Releases a previous acquire
+             */
+            void release()
+            {
+                uint8_t count = hold_count_.load(std::memory_order_relaxed);
+                if (count > 0)
+                    hold_count_.store(count - 1, std::memory_order_release);
+            }
+
+            /**
+             * @brief Determines if any entity currently holds the bus
+             */
+            bool is_acquired() const
+            {
+                return hold_count_.load(std::memory_order_acquire) > 0;
+            }
+
+        private:
+            /**
+             * @brief Writes a single frame to the mainboard, or hands it to the bridge task
+             *
+             * @param command message to send
+             * @return false if the ring to the bridge task is full and the frame has not been sent
+             */
+            bool transmit(const Command &command);
+
+            /**
+             * @brief Removes the message in flight and updates the acknowledgement statistics
+             *
+             * @param acknowledged true if the mainboard has changed an expected led
+             */
+            void finish_acknowledgement(bool acknowledged);
+
+            /**
+             * @brief Number of frames an acknowledged message may use
+             *
+             * @param frames number of frames requested by the entity
+             */
+            uint16_t ack_frame_limit(uint16_t frames) const;
+
+            /// @brief reference to uart connected to the mainboard
+            uart::UARTDevice *mainboard_uart_ = nullptr;
+
+            /// @brief reassembles display messages
+            FrameReader<DISPLAY_FRAME_SIZE> display_frame_reader_;
+
+            /// @brief true if frames are written by the bridge task, only accessed by the component loop
+            bool deferred_transmission_ = false;
+
+            /// @brief frames sent by loop() which the bridge task still has to write
+            SpscRing<Command, TX_RING_SIZE> deferred_frames_;
+
+            /// @brief true if bytes have been written to the mainboard since the last take_tx_pending()
+            std::atomic<bool> tx_pending_{false};
+
+            /// @brief time at which the last complete display message has been received
+            std::atomic<uint32_t> last_display_frame_time_{0};
+
+            /// @brief number of active bus acquisitions
+            std::atomic<uint8_t> hold_count_{0};
+
+            /// @brief A queued message
+            struct TxEntry
+            {
+                /// @brief message to send
+                Command command;
+                /// @brief number of frames which still have to be sent
+                uint16_t remaining;
+                /// @brief minimum time in ms since the previous frame before the first frame is sent
+                uint16_t gap;
+                /// @brief leds which acknowledge the message when they change, 0 if it is not acknowledged
+                uint16_t ack_leds;
+                /// @brief number of frames which have been sent
+                uint16_t sent;
+            };
+
+            /// @brief Fixed size ring of messages
+            struct TxQueue
+            {
+                TxEntry entries[TX_QUEUE_SIZE];
+                uint8_t head = 0;
+                uint8_t count = 0;
+            };
+
+            /// @brief one queue per priority
+            TxQueue queues_[TX_PRIORITY_COUNT];
+
+            /// @brief time at which the last queued frame or status request was sent
+            uint32_t last_transmission_ = 0;
+
+            /// @brief interval in ms in which status requests are sent, 0 if the display is not emulated
+            uint32_t status_request_interval_ = 0;
+
+            /// @brief number of messages dropped due to full queues
+            uint32_t dropped_count_ = 0;
+
+            /// @brief queue whose head message awaits an acknowledgement, nullptr if none
+            TxQueue *ack_queue_ = nullptr;
+
+            /// @brief leds of the most recent mainboard message
+            std::array<uint8_t, LED_COUNT> last_leds_ = {};
+
+            /// @brief leds before the message in flight has been sent for the first time
+            std::array<uint8_t, LED_COUNT> ack_leds_ = {};
+
+            /// @brief mainboard messages received since the last frame of the message in flight
+            uint8_t frames_since_transmission_ = 0;
+
+            /// @brief running average of the frames acknowledged button and setting messages needed
+            float ack_mean_ = 0;
+
+            /// @brief nr of acknowledged messages confirmed by the mainboard
+            uint32_t ack_delivered_ = 0;
+
+            /// @brief nr of confirmed messages which contributed to the running average, power messages are excluded
+            uint32_t ack_learned_ = 0;
+
+            /// @brief nr of acknowledged messages which have not been confirmed
+            uint32_t ack_failed_ = 0;
+
+            /// @brief total frames sent for confirmed messages
+            uint32_t ack_frames_sum_ = 0;
+        };
+
+    } // namespace philips_coffee_machine
+} // namespace esphome
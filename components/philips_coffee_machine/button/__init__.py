@@ -35,7 +35,7 @@ ACTIONS = {
     "MAKE_AMERICANO": Action.MAKE_AMERICANO,
     "BEAN": Action.SELECT_BEAN,
     "SIZE": Action.SELECT_SIZE,
-    "MILK": Action.MILK,
+    "MILK": Action.SELECT_MILK,
     "AQUA_CLEAN": Action.SELECT_AQUA_CLEAN,
     "CALC_CLEAN": Action.SELECT_CALC_CLEAN,
     "PLAY_PAUSE": Action.PLAY_PAUSE,
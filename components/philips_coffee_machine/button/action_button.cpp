@@ -1,5 +1,6 @@
 #include "esphome/core/log.h"
 #include "action_button.h"
+#include "../drinks.h"
 
 namespace esphome
 {
@@ -10,6 +11,48 @@ namespace esphome
 
             static const char *const TAG = "philips-action-button";
 
+            /**
+             * @brief Button press(es) performed by an action
+             */
+            struct ActionCommand
+            {
+                /// @brief button which is pressed, nullptr if the action is not available on this model
+                const Command *command;
+                /// @brief true if play/pause is pressed after the button
+                bool press_play;
+                /// @brief drink which is queued instead for make actions, DRINK_COUNT if the drink can not be queued
+                Drink drink;
+                /// @brief leds which acknowledge the button press, 0 if its effect is not known
+                uint16_t ack_leds;
+            };
+
+            /// @brief Action to command mapping, indexed by Action
+            static constexpr ActionCommand action_commands[] = {
+                {command_coffee, false, DRINK_COFFEE, LEDS_DRINK},              // SELECT_COFFEE
+                {command_coffee, true, DRINK_COFFEE, LEDS_DRINK},               // MAKE_COFFEE
+                {command_espresso, false, DRINK_ESPRESSO, LEDS_DRINK},          // SELECT_ESPRESSO
+                {command_espresso, true, DRINK_ESPRESSO, LEDS_DRINK},           // MAKE_ESPRESSO
+                {command_espresso_lungo, false, DRINK_COUNT, LEDS_DRINK},       // SELECT_ESPRESSO_LUNGO
+                {command_espresso_lungo, true, DRINK_COUNT, LEDS_DRINK},        // MAKE_ESPRESSO_LUNGO
+                {command_hot_water, false, DRINK_HOT_WATER, LEDS_DRINK},        // SELECT_HOT_WATER
+                {command_hot_water, true, DRINK_HOT_WATER, LEDS_DRINK},         // MAKE_HOT_WATER
+                {command_steam, false, DRINK_STEAM, LEDS_DRINK},                // SELECT_STEAM
+                {command_steam, true, DRINK_STEAM, LEDS_DRINK},                 // MAKE_STEAM
+                {command_cappuccino, false, DRINK_CAPPUCCINO, LEDS_DRINK},      // SELECT_CAPPUCCINO
+                {command_cappuccino, true, DRINK_CAPPUCCINO, LEDS_DRINK},       // MAKE_CAPPUCCINO
+                {command_latte, false, DRINK_LATTE, LEDS_DRINK},                // SELECT_LATTE
+                {command_latte, true, DRINK_LATTE, LEDS_DRINK},                 // MAKE_LATTE
+                {command_americano, false, DRINK_AMERICANO, LEDS_DRINK},        // SELECT_AMERICANO
+                {command_americano, true, DRINK_AMERICANO, LEDS_DRINK},         // MAKE_AMERICANO
+                {&command_press_bean, false, DRINK_COUNT, LEDS_BEAN},           // SELECT_BEAN
+                {&command_press_size, false, DRINK_COUNT, LEDS_SIZE},           // SELECT_SIZE
+                {command_milk, false, DRINK_COUNT, LEDS_MILK},                  // SELECT_MILK
+                {&command_press_aqua_clean, false, DRINK_COUNT, 0},             // SELECT_AQUA_CLEAN
+                {&command_press_calc_clean, false, DRINK_COUNT, 0},             // SELECT_CALC_CLEAN
+                {&command_press_play_pause, false, DRINK_COUNT, LEDS_BREW},     // PLAY_PAUSE
+            };
+            static_assert(sizeof(action_commands) / sizeof(ActionCommand) == ACTION_COUNT, "Every action requires a command table entry");
+
             void ActionButton::dump_config()
             {
                 LOG_BUTTON("", "Philips Action Button", this);
@@ -25,19 +68,23 @@ namespace esphome
                         last_message_sent_ = millis();
                         perform_action();
                     }
-                    is_long_pressing_ = true;
+                    if (!is_long_pressing_)
+                    {
+                        is_long_pressing_ = true;
+                        bus_->acquire();
+                    }
                 }
-                else
+                else if (is_long_pressing_)
                 {
                     is_long_pressing_ = false;
+                    bus_->release();
                 }
             }
 
-            void ActionButton::write_array(const std::vector<uint8_t> &data)
+            void ActionButton::write_array(const Command &data, uint16_t gap, uint16_t ack_leds)
             {
-                for (unsigned int i = 0; i <= MESSAGE_REPETITIONS; i++)
-                    mainboard_uart_->write_array(data);
-                mainboard_uart_->flush();
+                // Long presses have to be held for their full duration, everything else stops once the mainboard reacts
+                bus_->enqueue(data, TX_PRIORITY_ACTION, MESSAGE_REPETITIONS, gap, should_long_press_ ? 0 : ack_leds);
             }
 
             void ActionButton::press_action()
@@ -55,131 +102,41 @@ namespace esphome
                 }
             }
 
-            void ActionButton::execute_command(const std::vector<uint8_t> &command)
+            void ActionButton::perform_action()
             {
-                auto action = action_;
-
-                write_array(command);
-                
-                if (
-                    action == SELECT_COFFEE 
-                    || action == SELECT_ESPRESSO
-                    || action == SELECT_ESPRESSO_LUNGO
-                    || action == SELECT_HOT_WATER
-                    || action == SELECT_STEAM
-                    || action == SELECT_CAPPUCCINO
-                    || action == SELECT_LATTE
-                    || action == SELECT_AMERICANO
-                ) return;
-
-                delay(BUTTON_SEQUENCE_DELAY);
-                write_array(command_press_play_pause);
+                if (action_ >= ACTION_COUNT || action_commands[action_].command == nullptr)
+                {
+                    ESP_LOGE(TAG, "Invalid Action provided!");
+                    return;
+                }
 
-            }
+                const ActionCommand &action_command = action_commands[action_];
 
-            void ActionButton::perform_action()
-            {
-                auto action = action_;
-
-                // These are what the commands are mapped to.
-                // command[0] - Coffee
-                // command[1] - Espresso
-                // command[2] - Hot Water
-                // command[3] - Steam
-                // command[4] - Cappuccino
-                // command[5] - Latte
-                // command[6] - Americano
-                // command[7] - Espresso Lungo
-
-                // Default for most models
-                std::vector<uint8_t> command[8] {
-                    command_press_1,
-                    command_press_2,
-                    command_press_3
-                };
-
-                // command additions and overrides for specific models
-                #ifdef PHILIPS_EP2220
-                    command[3] = command_press_4;
-                #endif
-
-                #ifdef PHILIPS_EP2235
-                    command[4] = command_press_4;
-                #endif
-
-                #ifdef PHILIPS_EP3221
-                    command[0] = command_press_5;
-                    command[2] = command_press_4;
-                    command[3] = command_press_3;
-                    command[6] = command_press_6;
-                    command[7] = command_press_1;
-                #endif
-
-                #ifdef PHILIPS_EP3243
-                    command[4] = command_press_6;
-                    command[5] = command_press_4;
-                    command[6] = command_press_5;
-                #endif
-                
-                switch (action) {
-                    case SELECT_COFFEE:
-                    case MAKE_COFFEE:
-                        execute_command(command[0]);
-                        break;
-                    case SELECT_ESPRESSO:
-                    case MAKE_ESPRESSO:
-                        execute_command(command[1]);
-                        break;
-                    case SELECT_HOT_WATER:
-                    case MAKE_HOT_WATER:
-                        execute_command(command[2]);
-                        break;
-                    case SELECT_STEAM:
-                    case MAKE_STEAM:
-                        execute_command(command[3]);
-                        break;
-                    case SELECT_CAPPUCCINO:
-                    case MAKE_CAPPUCCINO:
-                        execute_command(command[4]);
-                        break;
-                    case SELECT_LATTE:
-                    case MAKE_LATTE:
-                        execute_command(command[5]);
-                        break;
-                    case SELECT_AMERICANO:
-                    case MAKE_AMERICANO:
-                        execute_command(command[6]);
-                        break;
-                    case SELECT_ESPRESSO_LUNGO:
-                    case MAKE_ESPRESSO_LUNGO:
-                        execute_command(command[7]);
-                        break;
-                    case PLAY_PAUSE:
-                        write_array(command_press_play_pause);
-                        break;
-                    case SELECT_BEAN:
-                        write_array(command_press_bean);
-                        break;
-                    case SELECT_SIZE:
-                        write_array(command_press_size);
-                        break;
-#if defined(PHILIPS_EP3243)
-                    case SELECT_MILK:
-                        write_array(command_press_milk);
-                        break;
-#endif
-                    case SELECT_AQUA_CLEAN:
-                        write_array(command_press_aqua_clean);
-                        break;
-                    case SELECT_CALC_CLEAN:
-                        write_array(command_press_calc_clean);
-                        break;
-                    default:
-                        ESP_LOGE(TAG, "Invalid Action provided!");
+                // Drinks are queued, the controller brews them one after another once the machine is ready
+                // Drinks whose selection can not be decoded on this model are selected and started blindly instead
+                if (action_command.press_play && action_command.drink != DRINK_COUNT && drink_queue_ != nullptr &&
+                    is_selection_decodable(action_command.drink, false))
+                {
+                    if (snapshot_ != nullptr && snapshot_->state == MachineState::OFF)
+                    {
+                        ESP_LOGW(TAG, "Machine is off, drink request rejected");
+                        return;
+                    }
+
+                    Recipe recipe;
+                    recipe.drink = action_command.drink;
+                    if (!drink_queue_->push(recipe))
+                        ESP_LOGW(TAG, "Drink queue full, request dropped");
+                    return;
                 }
 
-            }
+                write_array(*action_command.command, 0, action_command.ack_leds);
 
+                if (!action_command.press_play)
+                    return;
+
+                write_array(command_press_play_pause, BUTTON_SEQUENCE_DELAY, LEDS_BREW);
+            }
 
         } // namespace philips_action_button
     }     // namespace philips_coffee_machine
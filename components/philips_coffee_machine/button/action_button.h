@@ -2,8 +2,9 @@
 
 #include "esphome/core/component.h"
 #include "esphome/components/button/button.h"
-#include "esphome/components/uart/uart.h"
+#include "../bus_arbiter.h"
 #include "../commands.h"
+#include "../drink_queue.h"
 
 #define MESSAGE_REPETITIONS 5
 #define BUTTON_SEQUENCE_DELAY 100
@@ -45,6 +46,7 @@ namespace esphome
                 SELECT_AQUA_CLEAN,
                 SELECT_CALC_CLEAN,
                 PLAY_PAUSE,
+                ACTION_COUNT,
             };
 
             /**
@@ -68,42 +70,54 @@ namespace esphome
                 };
 
                 /**
-                 * @brief Reference to uart which is connected to the mainboard
+                 * @brief Reference to the arbiter of the mainboard bus
                  *
-                 * @param uart uart connected to mainboard
+                 * @param bus bus arbiter
                  */
-                void set_uart_device(uart::UARTDevice *uart)
+                void set_bus(BusArbiter *bus)
                 {
-                    mainboard_uart_ = uart;
+                    bus_ = bus;
                 };
 
                 /**
-                 * @brief Sets the long press parameter on this button component.
+                 * @brief Reference to the drink queue of the controller. Make actions are queued instead of being sent immediately.
                  *
-                 * @param long_press True if a long press should be executed, false otherwise
+                 * @param queue drink queue
                  */
-                void set_long_press(bool long_press)
+                void set_drink_queue(DrinkQueue *queue)
                 {
-                    should_long_press_ = long_press;
+                    drink_queue_ = queue;
                 }
 
                 /**
-                 * @brief Determines if the button is currently performing a long press
+                 * @brief Sets the snapshot reference, drinks are not queued while the machine is off
                  *
-                 * @return True if the button is currently performing a long press
+                 * @param snapshot hub components decoded machine snapshot
                  */
-                bool is_long_pressing()
+                void set_machine_snapshot(const MachineSnapshot *snapshot)
                 {
-                    return is_long_pressing_;
+                    snapshot_ = snapshot;
+                }
+
+                /**
+                 * @brief Sets the long press parameter on this button component.
+                 *
+                 * @param long_press True if a long press should be executed, false otherwise
+                 */
+                void set_long_press(bool long_press)
+                {
+                    should_long_press_ = long_press;
                 }
 
             private:
                 /**
-                 * @brief Writes data MESSAGE_REPETITIONS times to the mainboard uart
+                 * @brief Queues data MESSAGE_REPETITIONS times for the mainboard uart
                  *
                  * @param data Data to send
+                 * @param gap time in ms which has to pass after the previous message
+                 * @param ack_leds leds which acknowledge the message, ignored for long presses
                  */
-                void write_array(const std::vector<uint8_t> &data);
+                void write_array(const Command &data, uint16_t gap = 0, uint16_t ack_leds = 0);
 
                 /**
                  * @brief Executes button press
@@ -111,8 +125,6 @@ namespace esphome
                  */
                 void press_action() override;
 
-                void execute_command(const std::vector<uint8_t> &command);
-
                 /**
                  * @brief Writes the button to uart or initializes loop based message sending
                  *
@@ -121,11 +133,15 @@ namespace esphome
 
                 /// @brief Action used by this Button
                 Action action_;
-                /// @brief reference to uart connected to mainboard
-                uart::UARTDevice *mainboard_uart_;
+                /// @brief arbiter of the mainboard bus
+                BusArbiter *bus_;
+                /// @brief queue of drinks which are brewed one after another
+                DrinkQueue *drink_queue_ = nullptr;
+                /// @brief decoded machine snapshot of the controller
+                const MachineSnapshot *snapshot_ = nullptr;
                 /// @brief time in ms for how long the button should be pressed.
                 bool should_long_press_ = false;
-                /// @brief true if the component is currently performing a long press
+                /// @brief true if the component currently holds the bus for a long press
                 bool is_long_pressing_ = false;
                 /// @brief time at which the button press was started
                 uint32_t press_start_ = -(LONG_PRESS_DURATION + 1);
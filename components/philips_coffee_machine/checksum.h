@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        /// @brief CRC-16 polynomial (x^16 + x^12 + x^5 + 1) used by both the display and the mainboard
+        static constexpr uint16_t CHECKSUM_POLYNOMIAL = 0x1021;
+
+        /// @brief CRC register value before the first byte (start bytes included) is processed
+        static constexpr uint16_t CHECKSUM_INIT = 0xAAAA;
+
+        /// @brief number of checksum bytes at the end of every frame
+        static constexpr std::size_t CHECKSUM_SIZE = 2;
+
+        /**
+         * @brief Computes the CRC register contribution of a single nibble.
+         *
+         * @param nibble 4 bit value
+         * @return table entry for the given nibble
+         */
+        constexpr uint16_t checksum_table_entry(uint8_t nibble)
+        {
+            uint16_t crc = nibble << 12;
+            for (int i = 0; i < 4; i++)
+                crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ CHECKSUM_POLYNOMIAL) : (uint16_t)(crc << 1);
+            return crc;
+        }
+
+        /// @brief nibble lookup table, small enough to not matter on the ESP8266
+        static constexpr uint16_t checksum_table[16] = {
+            checksum_table_entry(0x0), checksum_table_entry(0x1), checksum_table_entry(0x2), checksum_table_entry(0x3),
+            checksum_table_entry(0x4), checksum_table_entry(0x5), checksum_table_entry(0x6), checksum_table_entry(0x7),
+            checksum_table_entry(0x8), checksum_table_entry(0x9), checksum_table_entry(0xA), checksum_table_entry(0xB),
+            checksum_table_entry(0xC), checksum_table_entry(0xD), checksum_table_entry(0xE), checksum_table_entry(0xF)};
+
+        /**
+         * @brief Computes the raw CRC-16 over the given bytes (MSB first, no final XOR).
+         *
+         * @param data bytes to process, starting with the message header
+         * @param length number of bytes to process
+         * @return CRC register value
+         */
+        constexpr uint16_t compute_crc(const uint8_t *data, std::size_t length)
+        {
+            uint16_t crc = CHECKSUM_INIT;
+            for (std::size_t i = 0; i < length; i++)
+            {
+                crc = (uint16_t)(crc << 4) ^ checksum_table[(crc >> 12) ^ (data[i] >> 4)];
+                crc = (uint16_t)(crc << 4) ^ checksum_table[(crc >> 12) ^ (data[i] & 0x0F)];
+            }
+            return crc;
+        }
+
+        /**
+         * @brief First checksum byte of a frame.
+         * Only the upper 6 bits of each CRC byte are transmitted, which keeps every byte on the bus below 0x40.
+         *
+         * @param crc CRC register value
+         */
+        constexpr uint8_t checksum_low(uint16_t crc)
+        {
+            return (crc & 0xFF) >> 2;
+        }
+
+        /**
+         * @brief Second checksum byte of a frame.
+         *
+         * @param crc CRC register value
+         */
+        constexpr uint8_t checksum_high(uint16_t crc)
+        {
+            return (crc >> 8) >> 2;
+        }
+
+        /**
+         * @brief Validates the trailing checksum of a complete frame.
+         *
+         * @param frame complete frame including header and checksum
+         * @param length length of the frame
+         * @return true if the checksum matches the frame content
+         */
+        constexpr bool is_valid_frame(const uint8_t *frame, std::size_t length)
+        {
+            if (length <= CHECKSUM_SIZE)
+                return false;
+
+            uint16_t crc = compute_crc(frame, length - CHECKSUM_SIZE);
+            return frame[length - 2] == checksum_low(crc) && frame[length - 1] == checksum_high(crc);
+        }
+
+    } // namespace philips_coffee_machine
+} // namespace esphome
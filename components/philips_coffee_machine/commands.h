@@ -1,102 +1,188 @@
 #pragma once
+#include <array>
+#include <cstddef>
 #include <stdint.h>
-#include <vector>
+#include "checksum.h"
 
 namespace esphome
 {
     namespace philips_coffee_machine
     {
+        /// @brief length of messages sent from the display to the mainboard
+        static constexpr std::size_t DISPLAY_FRAME_SIZE = 12;
+
+        /// @brief length of messages sent from the mainboard to the display
+        static constexpr std::size_t MAINBOARD_FRAME_SIZE = 19;
+
+        /// @brief A complete message from the display to the mainboard
+        using Command = std::array<uint8_t, DISPLAY_FRAME_SIZE>;
+
+        /// @brief Model identification bytes (4 and 6) used by the EP2220 and EP2235
+        constexpr uint8_t model_id_ep2200[2] = {0x02, 0x02};
+
+        /// @brief Model identification bytes (4 and 6) used by the EP3221, EP3243 and EP3246
+        constexpr uint8_t model_id_ep3200[2] = {0x03, 0x0E};
+
 #if defined(PHILIPS_EP2220) || defined(PHILIPS_EP2235)
 #define USE_DEFAULT_PHILIPS_COMMAND_SET
 #elif defined(PHILIPS_EP3243) || defined(PHILIPS_EP3221)
         // Note that the EP3243 and EP3246 are identical except for cosmetic differences
-        const uint8_t message_header[2] = {0xD5, 0x55};
+        constexpr uint8_t message_header[2] = {0xD5, 0x55};
+        inline constexpr const uint8_t (&model_id)[2] = model_id_ep3200;
         const uint8_t led_off = 0x00;
         const uint8_t led_half = 0x03;
         const uint8_t led_on = 0x07;
         const uint8_t led_second = 0x38;
         const uint8_t led_third = 0x3F;
-
-        const std::vector<uint8_t> command_pre_power_on =
-            {0xD5, 0x55, 0x0A, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x2A, 0x10};
-        const std::vector<uint8_t> command_power_with_cleaning =
-            {0xD5, 0x55, 0x02, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x1C, 0x17};
-        const std::vector<uint8_t> command_power_without_cleaning =
-            {0xD5, 0x55, 0x01, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x01, 0x25};
-        const std::vector<uint8_t> command_power_off =
-            {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x01, 0x00, 0x00, 0x39, 0x39};
-        const std::vector<uint8_t> command_press_play_pause =
-            {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x00, 0x01, 0x3D, 0x30};
-        /// @brief EP3243: Press Coffee Button; EP3221: Press Espresso Lungo Button
-        const std::vector<uint8_t> command_press_1 =
-            {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x08, 0x00, 0x00, 0x1D, 0x1E};
-        /// @brief EP3243: Press Espresso Button
-        const std::vector<uint8_t> command_press_2 =
-            {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x02, 0x00, 0x00, 0x2D, 0x2F};
-        /// @brief EP3243: Press Hot water Button; EP3221: Press Steam Button
-        const std::vector<uint8_t> command_press_3 =
-            {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x01, 0x00, 0x39, 0x38};
-        /// @brief EP3243: Press Latte Button; EP3221: Press Hot water Button
-        const std::vector<uint8_t> command_press_4 =
-            {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x10, 0x00, 0x00, 0x2D, 0x24};
-        /// @brief EP3243: Press Americano Button; EP3221: Press Coffee Button
-        const std::vector<uint8_t> command_press_5 =
-            {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x20, 0x00, 0x00, 0x04, 0x15};
-        /// @brief EP3243: Press Cappuccino Button; EP3221: Press Americano Button
-        const std::vector<uint8_t> command_press_6 =
-            {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x04, 0x00, 0x00, 0x05, 0x03};
-        const std::vector<uint8_t> command_press_bean =
-            {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x02, 0x00, 0x2D, 0x2D};
-        const std::vector<uint8_t> command_press_size =
-            {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x04, 0x00, 0x04, 0x07};
-        const std::vector<uint8_t> command_press_milk =
-            {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x08, 0x00, 0x1F, 0x16};
-        const std::vector<uint8_t> command_press_aqua_clean =
-            {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x10, 0x00, 0x29, 0x34};
-        const std::vector<uint8_t> command_press_calc_clean =
-            {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x20, 0x00, 0x0C, 0x35};
 #else
 #define USE_DEFAULT_PHILIPS_COMMAND_SET
 #endif
 
 #ifdef USE_DEFAULT_PHILIPS_COMMAND_SET
-        const uint8_t message_header[2] = {0xD5, 0x55};
+        constexpr uint8_t message_header[2] = {0xD5, 0x55};
+        inline constexpr const uint8_t (&model_id)[2] = model_id_ep2200;
         const uint8_t led_off = 0x00;
         const uint8_t led_half = 0x03;
         const uint8_t led_on = 0x07;
         const uint8_t led_second = 0x38;
         const uint8_t led_third = 0x3F;
+#endif
+
+        /**
+         * @brief Builds a message from the display to the mainboard including its checksum.
+         * Buttons within a group are encoded as individual bits, multiple bits result in a simultaneous button press.
+         *
+         * @param model model identification bytes (4 and 6)
+         * @param power power instruction (byte 2), 0x00 for regular button presses
+         * @param buttons_1 drink selection group/power off (byte 7)
+         * @param buttons_2 settings group (byte 8)
+         * @param buttons_3 play/pause (byte 9)
+         * @return complete message
+         */
+        constexpr Command build_command(const uint8_t (&model)[2], uint8_t power, uint8_t buttons_1, uint8_t buttons_2, uint8_t buttons_3)
+        {
+            // The checksum only covers the first 10 bytes, the trailing zeros are ignored
+            const Command content = {message_header[0], message_header[1], power, 0x01, model[0], 0x00, model[1], buttons_1, buttons_2, buttons_3, 0x00, 0x00};
+            const uint16_t crc = compute_crc(&content[0], DISPLAY_FRAME_SIZE - CHECKSUM_SIZE);
+            return {content[0], content[1], content[2], content[3], content[4], content[5], content[6], content[7], content[8], content[9], checksum_low(crc), checksum_high(crc)};
+        }
 
-        const std::vector<uint8_t> command_pre_power_on =
-            {0xD5, 0x55, 0x0A, 0x01, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00, 0x0E, 0x12};
-        const std::vector<uint8_t> command_power_with_cleaning =
-            {0xD5, 0x55, 0x02, 0x01, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00, 0x38, 0x15};
-        const std::vector<uint8_t> command_power_without_cleaning =
-            {0xD5, 0x55, 0x01, 0x01, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00, 0x25, 0x27};
-        const std::vector<uint8_t> command_power_off =
-            {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x01, 0x00, 0x00, 0x1D, 0x3B};
-        const std::vector<uint8_t> command_press_play_pause =
-            {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x00, 0x00, 0x01, 0x19, 0x32};
+        /**
+         * @brief Builds a message for the configured model including its checksum.
+         *
+         * @param power power instruction (byte 2), 0x00 for regular button presses
+         * @param buttons_1 drink selection group/power off (byte 7)
+         * @param buttons_2 settings group (byte 8)
+         * @param buttons_3 play/pause (byte 9)
+         * @return complete message
+         */
+        constexpr Command build_command(uint8_t power, uint8_t buttons_1, uint8_t buttons_2, uint8_t buttons_3)
+        {
+            return build_command(model_id, power, buttons_1, buttons_2, buttons_3);
+        }
+
+        /**
+         * @brief Combines two messages into a single message in which the buttons of both are pressed simultaneously.
+         * The button bits are ORed and the checksum is recomputed.
+         *
+         * @param a first message
+         * @param b second message
+         * @return message containing the button presses of both messages
+         */
+        constexpr Command combine_commands(const Command &a, const Command &b)
+        {
+            return build_command({a[4], a[6]}, a[2] | b[2], a[7] | b[7], a[8] | b[8], a[9] | b[9]);
+        }
+
+        /**
+         * @brief Compares two messages byte by byte.
+         */
+        constexpr bool commands_equal(const Command &a, const Command &b)
+        {
+            for (std::size_t i = 0; i < DISPLAY_FRAME_SIZE; i++)
+                if (a[i] != b[i])
+                    return false;
+            return true;
+        }
+
+        /// @brief Status request sent by the display whenever no button is pressed, the mainboard answers every message with its status
+        inline constexpr Command command_status_request = build_command(0x00, 0x00, 0x00, 0x00);
+        inline constexpr Command command_pre_power_on = build_command(0x0A, 0x00, 0x00, 0x00);
+        inline constexpr Command command_power_with_cleaning = build_command(0x02, 0x00, 0x00, 0x00);
+        inline constexpr Command command_power_without_cleaning = build_command(0x01, 0x00, 0x00, 0x00);
+        inline constexpr Command command_power_off = build_command(0x00, 0x01, 0x00, 0x00);
+        inline constexpr Command command_press_play_pause = build_command(0x00, 0x00, 0x00, 0x01);
+
+#ifdef USE_DEFAULT_PHILIPS_COMMAND_SET
         /// @brief EP2220: Press Coffee Button
-        const std::vector<uint8_t> command_press_1 =
-            {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x08, 0x00, 0x00, 0x39, 0x1C};
+        inline constexpr Command command_press_1 = build_command(0x00, 0x08, 0x00, 0x00);
         /// @brief EP2220: Press Espresso Button
-        const std::vector<uint8_t> command_press_2 =
-            {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x02, 0x00, 0x00, 0x09, 0x2D};
+        inline constexpr Command command_press_2 = build_command(0x00, 0x02, 0x00, 0x00);
         /// @brief EP2220: Press Hot Water Button
-        const std::vector<uint8_t> command_press_3 =
-            {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x04, 0x00, 0x00, 0x21, 0x01};
+        inline constexpr Command command_press_3 = build_command(0x00, 0x04, 0x00, 0x00);
         /// @brief EP2220: Press Steam Button; EP2235 Press Cappuccino Button
-        const std::vector<uint8_t> command_press_4 =
-            {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x10, 0x00, 0x00, 0x09, 0x26};
-        const std::vector<uint8_t> command_press_bean =
-            {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x00, 0x02, 0x00, 0x09, 0x2F};
-        const std::vector<uint8_t> command_press_size =
-            {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x00, 0x04, 0x00, 0x20, 0x05};
-        const std::vector<uint8_t> command_press_aqua_clean =
-            {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x00, 0x10, 0x00, 0x0D, 0x36};
-        const std::vector<uint8_t> command_press_calc_clean =
-            {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x00, 0x20, 0x00, 0x28, 0x37};
+        inline constexpr Command command_press_4 = build_command(0x00, 0x10, 0x00, 0x00);
+        inline constexpr Command command_press_bean = build_command(0x00, 0x00, 0x02, 0x00);
+        inline constexpr Command command_press_size = build_command(0x00, 0x00, 0x04, 0x00);
+        inline constexpr Command command_press_aqua_clean = build_command(0x00, 0x00, 0x10, 0x00);
+        inline constexpr Command command_press_calc_clean = build_command(0x00, 0x00, 0x20, 0x00);
+#else
+        /// @brief EP3243: Press Coffee Button; EP3221: Press Espresso Lungo Button
+        inline constexpr Command command_press_1 = build_command(0x00, 0x08, 0x00, 0x00);
+        /// @brief EP3243: Press Espresso Button
+        inline constexpr Command command_press_2 = build_command(0x00, 0x02, 0x00, 0x00);
+        /// @brief EP3243: Press Hot water Button; EP3221: Press Steam Button
+        inline constexpr Command command_press_3 = build_command(0x00, 0x00, 0x01, 0x00);
+        /// @brief EP3243: Press Latte Button; EP3221: Press Hot water Button
+        inline constexpr Command command_press_4 = build_command(0x00, 0x10, 0x00, 0x00);
+        /// @brief EP3243: Press Americano Button; EP3221: Press Coffee Button
+        inline constexpr Command command_press_5 = build_command(0x00, 0x20, 0x00, 0x00);
+        /// @brief EP3243: Press Cappuccino Button; EP3221: Press Americano Button
+        inline constexpr Command command_press_6 = build_command(0x00, 0x04, 0x00, 0x00);
+        inline constexpr Command command_press_bean = build_command(0x00, 0x00, 0x02, 0x00);
+        inline constexpr Command command_press_size = build_command(0x00, 0x00, 0x04, 0x00);
+        inline constexpr Command command_press_milk = build_command(0x00, 0x00, 0x08, 0x00);
+        inline constexpr Command command_press_aqua_clean = build_command(0x00, 0x00, 0x10, 0x00);
+        inline constexpr Command command_press_calc_clean = build_command(0x00, 0x00, 0x20, 0x00);
 #endif
+
+        // The builder must reproduce every message which has been recorded from the bus
+        // EP2220/EP2235
+        static_assert(commands_equal(build_command(model_id_ep2200, 0x00, 0x00, 0x00, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00, 0x11, 0x36}), "status request");
+        static_assert(commands_equal(build_command(model_id_ep2200, 0x0A, 0x00, 0x00, 0x00), {0xD5, 0x55, 0x0A, 0x01, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00, 0x0E, 0x12}), "pre power on");
+        static_assert(commands_equal(build_command(model_id_ep2200, 0x02, 0x00, 0x00, 0x00), {0xD5, 0x55, 0x02, 0x01, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00, 0x38, 0x15}), "power with cleaning");
+        static_assert(commands_equal(build_command(model_id_ep2200, 0x01, 0x00, 0x00, 0x00), {0xD5, 0x55, 0x01, 0x01, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00, 0x25, 0x27}), "power without cleaning");
+        static_assert(commands_equal(build_command(model_id_ep2200, 0x00, 0x01, 0x00, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x01, 0x00, 0x00, 0x1D, 0x3B}), "power off");
+        static_assert(commands_equal(build_command(model_id_ep2200, 0x00, 0x00, 0x00, 0x01), {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x00, 0x00, 0x01, 0x19, 0x32}), "play/pause");
+        static_assert(commands_equal(build_command(model_id_ep2200, 0x00, 0x08, 0x00, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x08, 0x00, 0x00, 0x39, 0x1C}), "button 1");
+        static_assert(commands_equal(build_command(model_id_ep2200, 0x00, 0x02, 0x00, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x02, 0x00, 0x00, 0x09, 0x2D}), "button 2");
+        static_assert(commands_equal(build_command(model_id_ep2200, 0x00, 0x04, 0x00, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x04, 0x00, 0x00, 0x21, 0x01}), "button 3");
+        static_assert(commands_equal(build_command(model_id_ep2200, 0x00, 0x10, 0x00, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x10, 0x00, 0x00, 0x09, 0x26}), "button 4");
+        static_assert(commands_equal(build_command(model_id_ep2200, 0x00, 0x00, 0x02, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x00, 0x02, 0x00, 0x09, 0x2F}), "bean");
+        static_assert(commands_equal(build_command(model_id_ep2200, 0x00, 0x00, 0x04, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x00, 0x04, 0x00, 0x20, 0x05}), "size");
+        static_assert(commands_equal(build_command(model_id_ep2200, 0x00, 0x00, 0x10, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x00, 0x10, 0x00, 0x0D, 0x36}), "aqua clean");
+        static_assert(commands_equal(build_command(model_id_ep2200, 0x00, 0x00, 0x20, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x02, 0x00, 0x02, 0x00, 0x20, 0x00, 0x28, 0x37}), "calc clean");
+        // EP3221/EP3243/EP3246
+        static_assert(commands_equal(build_command(model_id_ep3200, 0x0A, 0x00, 0x00, 0x00), {0xD5, 0x55, 0x0A, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x2A, 0x10}), "pre power on");
+        static_assert(commands_equal(build_command(model_id_ep3200, 0x02, 0x00, 0x00, 0x00), {0xD5, 0x55, 0x02, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x1C, 0x17}), "power with cleaning");
+        static_assert(commands_equal(build_command(model_id_ep3200, 0x01, 0x00, 0x00, 0x00), {0xD5, 0x55, 0x01, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x01, 0x25}), "power without cleaning");
+        static_assert(commands_equal(build_command(model_id_ep3200, 0x00, 0x01, 0x00, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x01, 0x00, 0x00, 0x39, 0x39}), "power off");
+        static_assert(commands_equal(build_command(model_id_ep3200, 0x00, 0x00, 0x00, 0x01), {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x00, 0x01, 0x3D, 0x30}), "play/pause");
+        static_assert(commands_equal(build_command(model_id_ep3200, 0x00, 0x08, 0x00, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x08, 0x00, 0x00, 0x1D, 0x1E}), "button 1");
+        static_assert(commands_equal(build_command(model_id_ep3200, 0x00, 0x02, 0x00, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x02, 0x00, 0x00, 0x2D, 0x2F}), "button 2");
+        static_assert(commands_equal(build_command(model_id_ep3200, 0x00, 0x00, 0x01, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x01, 0x00, 0x39, 0x38}), "button 3");
+        static_assert(commands_equal(build_command(model_id_ep3200, 0x00, 0x10, 0x00, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x10, 0x00, 0x00, 0x2D, 0x24}), "button 4");
+        static_assert(commands_equal(build_command(model_id_ep3200, 0x00, 0x20, 0x00, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x20, 0x00, 0x00, 0x04, 0x15}), "button 5");
+        static_assert(commands_equal(build_command(model_id_ep3200, 0x00, 0x04, 0x00, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x04, 0x00, 0x00, 0x05, 0x03}), "button 6");
+        static_assert(commands_equal(build_command(model_id_ep3200, 0x00, 0x00, 0x02, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x02, 0x00, 0x2D, 0x2D}), "bean");
+        static_assert(commands_equal(build_command(model_id_ep3200, 0x00, 0x00, 0x04, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x04, 0x00, 0x04, 0x07}), "size");
+        static_assert(commands_equal(build_command(model_id_ep3200, 0x00, 0x00, 0x08, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x08, 0x00, 0x1F, 0x16}), "milk");
+        static_assert(commands_equal(build_command(model_id_ep3200, 0x00, 0x00, 0x10, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x10, 0x00, 0x29, 0x34}), "aqua clean");
+        static_assert(commands_equal(build_command(model_id_ep3200, 0x00, 0x00, 0x20, 0x00), {0xD5, 0x55, 0x00, 0x01, 0x03, 0x00, 0x0E, 0x00, 0x20, 0x00, 0x0C, 0x35}), "calc clean");
+
+        // Combining presses must result in the message with the bits of both buttons set
+        static_assert(commands_equal(combine_commands(command_press_1, command_press_bean), build_command(0x00, 0x08, 0x02, 0x00)), "button 1 + bean");
+        static_assert(commands_equal(combine_commands(command_press_size, command_press_play_pause), combine_commands(command_press_play_pause, command_press_size)), "order of combined presses");
+        static_assert(commands_equal(combine_commands(command_press_2, command_status_request), command_press_2), "status request adds no press");
     } // namespace philips_coffee_machine
 } // namespace esphome
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <stdint.h>
+#include "recipe_engine.h"
+
+#define DRINK_QUEUE_SIZE 4
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        /**
+         * @brief Bounded queue of requested drinks.
+         * Requests are only stored here, the controller starts the next recipe as soon as the machine is ready again.
+         */
+        class DrinkQueue
+        {
+        public:
+            /**
+             * @brief Appends a drink request
+             *
+             * @param recipe drink and settings
+             * @return false if the queue is full
+             */
+            bool push(const Recipe &recipe)
+            {
+                if (count_ == DRINK_QUEUE_SIZE)
+                    return false;
+
+                recipes_[(head_ + count_) % DRINK_QUEUE_SIZE] = recipe;
+                count_++;
+                return true;
+            }
+
+            /**
+             * @brief Removes the oldest drink request
+             *
+             * @param recipe receives the request
+             * @return false if the queue is empty
+             */
+            bool pop(Recipe &recipe)
+            {
+                if (count_ == 0)
+                    return false;
+
+                recipe = recipes_[head_];
+                head_ = (head_ + 1) % DRINK_QUEUE_SIZE;
+                count_--;
+                served_++;
+                return true;
+            }
+
+            /**
+             * @brief Drops all waiting requests
+             */
+            void clear()
+            {
+                count_ = 0;
+                served_ = 0;
+            }
+
+            /**
+             * @brief Number of waiting requests
+             */
+            uint8_t size() const
+            {
+                return count_;
+            }
+
+            /**
+             * @brief Number of requests taken from the queue since it last ran empty, i.e. the position of the current drink
+             */
+            uint8_t position() const
+            {
+                return served_;
+            }
+
+            /**
+             * @brief Restarts counting the position, called once the last drink has been prepared
+             */
+            void reset_position()
+            {
+                served_ = 0;
+            }
+
+        private:
+            /// @brief fixed size ring of requests
+            Recipe recipes_[DRINK_QUEUE_SIZE];
+
+            /// @brief index of the oldest request
+            uint8_t head_ = 0;
+
+            /// @brief nr of waiting requests
+            uint8_t count_ = 0;
+
+            /// @brief nr of requests taken since the queue last ran empty
+            uint8_t served_ = 0;
+        };
+
+    } // namespace philips_coffee_machine
+} // namespace esphome
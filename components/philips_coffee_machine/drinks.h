@@ -0,0 +1,169 @@
+#pragma once
+
+#include "commands.h"
+#include "machine_state.h"
+#include "status_rules.h"
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        // Drink buttons of the configured model, nullptr if the drink is not available
+#if defined(PHILIPS_EP3221)
+        static constexpr const Command *command_coffee = &command_press_5;
+        static constexpr const Command *command_espresso = &command_press_2;
+        static constexpr const Command *command_hot_water = &command_press_4;
+        static constexpr const Command *command_steam = &command_press_3;
+        static constexpr const Command *command_cappuccino = nullptr;
+        static constexpr const Command *command_latte = nullptr;
+        static constexpr const Command *command_americano = &command_press_6;
+        static constexpr const Command *command_espresso_lungo = &command_press_1;
+        static constexpr const Command *command_milk = nullptr;
+#elif defined(PHILIPS_EP3243)
+        static constexpr const Command *command_coffee = &command_press_1;
+        static constexpr const Command *command_espresso = &command_press_2;
+        static constexpr const Command *command_hot_water = &command_press_3;
+        static constexpr const Command *command_steam = nullptr;
+        static constexpr const Command *command_cappuccino = &command_press_6;
+        static constexpr const Command *command_latte = &command_press_4;
+        static constexpr const Command *command_americano = &command_press_5;
+        static constexpr const Command *command_espresso_lungo = nullptr;
+        static constexpr const Command *command_milk = &command_press_milk;
+#elif defined(PHILIPS_EP2235)
+        static constexpr const Command *command_coffee = &command_press_1;
+        static constexpr const Command *command_espresso = &command_press_2;
+        static constexpr const Command *command_hot_water = &command_press_3;
+        static constexpr const Command *command_steam = nullptr;
+        static constexpr const Command *command_cappuccino = &command_press_4;
+        static constexpr const Command *command_latte = nullptr;
+        static constexpr const Command *command_americano = nullptr;
+        static constexpr const Command *command_espresso_lungo = nullptr;
+        static constexpr const Command *command_milk = nullptr;
+#else
+        static constexpr const Command *command_coffee = &command_press_1;
+        static constexpr const Command *command_espresso = &command_press_2;
+        static constexpr const Command *command_hot_water = &command_press_3;
+        static constexpr const Command *command_steam = &command_press_4;
+        static constexpr const Command *command_cappuccino = nullptr;
+        static constexpr const Command *command_latte = nullptr;
+        static constexpr const Command *command_americano = nullptr;
+        static constexpr const Command *command_espresso_lungo = nullptr;
+        static constexpr const Command *command_milk = nullptr;
+#endif
+
+        /**
+         * @brief Drinks which can be prepared by a recipe
+         */
+        enum Drink : uint8_t
+        {
+            DRINK_COFFEE = 0,
+            DRINK_ESPRESSO,
+            DRINK_HOT_WATER,
+            DRINK_STEAM,
+            DRINK_CAPPUCCINO,
+            DRINK_LATTE,
+            DRINK_AMERICANO,
+            DRINK_COUNT,
+        };
+
+        /**
+         * @brief Button which selects a drink on the configured model
+         *
+         * @param drink drink to select
+         * @return button message, nullptr if the drink is not available
+         */
+        constexpr const Command *drink_command(Drink drink)
+        {
+            switch (drink)
+            {
+            case DRINK_COFFEE:
+                return command_coffee;
+            case DRINK_ESPRESSO:
+                return command_espresso;
+            case DRINK_HOT_WATER:
+                return command_hot_water;
+            case DRINK_STEAM:
+                return command_steam;
+            case DRINK_CAPPUCCINO:
+                return command_cappuccino;
+            case DRINK_LATTE:
+                return command_latte;
+            case DRINK_AMERICANO:
+                return command_americano;
+            default:
+                return nullptr;
+            }
+        }
+
+        /**
+         * @brief State in which a single portion of a drink is selected
+         *
+         * @param drink selected drink
+         * @param ground true if ground coffee is used instead of beans
+         * @return selected state, UNKNOWN if the drink can not be made from ground coffee
+         */
+        constexpr MachineState selected_state(Drink drink, bool ground)
+        {
+            switch (drink)
+            {
+            case DRINK_COFFEE:
+                return ground ? MachineState::GROUND_COFFEE_SELECTED : MachineState::COFFEE_SELECTED;
+            case DRINK_ESPRESSO:
+                return ground ? MachineState::GROUND_ESPRESSO_SELECTED : MachineState::ESPRESSO_SELECTED;
+            case DRINK_CAPPUCCINO:
+                return ground ? MachineState::GROUND_CAPPUCCINO_SELECTED : MachineState::CAPPUCCINO_SELECTED;
+            case DRINK_LATTE:
+                return ground ? MachineState::GROUND_LATTE_SELECTED : MachineState::LATTE_SELECTED;
+            case DRINK_AMERICANO:
+                return ground ? MachineState::GROUND_AMERICANO_SELECTED : MachineState::AMERICANO_SELECTED;
+            case DRINK_HOT_WATER:
+                return ground ? MachineState::UNKNOWN : MachineState::HOT_WATER_SELECTED;
+            case DRINK_STEAM:
+                return ground ? MachineState::UNKNOWN : MachineState::STEAM_SELECTED;
+            default:
+                return MachineState::UNKNOWN;
+            }
+        }
+
+        /**
+         * @brief Determines if the selection of a drink can be recognized in the mainboard messages of the configured model
+         *
+         * @param drink selected drink
+         * @param ground true if ground coffee is used instead of beans
+         */
+        constexpr bool is_selection_decodable(Drink drink, bool ground)
+        {
+            MachineState state = selected_state(drink, ground);
+            return state != MachineState::UNKNOWN && has_status_rule(state);
+        }
+
+        /**
+         * @brief State in which a single portion of a drink is brewed
+         *
+         * @param drink drink being brewed
+         */
+        constexpr MachineState brewing_state(Drink drink)
+        {
+            switch (drink)
+            {
+            case DRINK_COFFEE:
+                return MachineState::COFFEE_BREWING;
+            case DRINK_ESPRESSO:
+                return MachineState::ESPRESSO_BREWING;
+            case DRINK_CAPPUCCINO:
+                return MachineState::CAPPUCCINO_BREWING;
+            case DRINK_LATTE:
+                return MachineState::LATTE_BREWING;
+            case DRINK_AMERICANO:
+                return MachineState::AMERICANO_BREWING;
+            case DRINK_HOT_WATER:
+                return MachineState::HOT_WATER_BREWING;
+            case DRINK_STEAM:
+                return MachineState::STEAM_BREWING;
+            default:
+                return MachineState::UNKNOWN;
+            }
+        }
+
+    } // namespace philips_coffee_machine
+} // namespace esphome
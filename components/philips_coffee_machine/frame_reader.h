@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <stdint.h>
+#include "commands.h"
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        /**
+         * @brief Incremental frame reassembly for the display/mainboard byte streams.
+         * Bytes are pushed one at a time, the reader hunts for the message header and accumulates the frame body.
+         * The state persists across calls, so a frame may be split across any number of loop iterations.
+         *
+         * @tparam N total length of a frame including header and checksum
+         */
+        template <std::size_t N>
+        class FrameReader
+        {
+        public:
+            /**
+             * @brief Feeds a single byte into the reader.
+             *
+             * @param byte received byte
+             * @return true if this byte completed a frame, which is then available through data()
+             */
+            bool push(uint8_t byte)
+            {
+                switch (state_)
+                {
+                case HEADER_START:
+                    if (byte == message_header[0])
+                        state_ = HEADER_END;
+                    return false;
+                case HEADER_END:
+                    if (byte == message_header[1])
+                    {
+                        buffer_[0] = message_header[0];
+                        buffer_[1] = message_header[1];
+                        index_ = 2;
+                        state_ = BODY;
+                    }
+                    else if (byte != message_header[0])
+                    {
+                        state_ = HEADER_START;
+                    }
+                    return false;
+                case BODY:
+                    buffer_[index_++] = byte;
+                    if (index_ < N)
+                        return false;
+                    state_ = HEADER_START;
+                    return true;
+                }
+                return false;
+            }
+
+            /**
+             * @brief Discards any partially received frame and restarts the header hunt.
+             */
+            void reset()
+            {
+                state_ = HEADER_START;
+                index_ = 0;
+            }
+
+            /**
+             * @brief Determines if a frame has been started but not yet completed
+             */
+            bool in_frame() const
+            {
+                return state_ != HEADER_START;
+            }
+
+            /**
+             * @brief The most recently completed frame (N bytes). Only valid directly after push() returned true.
+             */
+            const uint8_t *data() const
+            {
+                return buffer_;
+            }
+
+        private:
+            /// @brief Reassembly states
+            enum State
+            {
+                HEADER_START,
+                HEADER_END,
+                BODY,
+            };
+
+            /// @brief current reassembly state
+            State state_ = HEADER_START;
+
+            /// @brief number of bytes currently stored in the buffer
+            std::size_t index_ = 0;
+
+            /// @brief frame being assembled
+            uint8_t buffer_[N] = {0x00};
+        };
+
+    } // namespace philips_coffee_machine
+} // namespace esphome
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <stdint.h>
+#include "machine_snapshot.h"
+
+// Time after a change during which a led is considered blinking, until the blink period has been learned
+#define BLINK_THRESHOLD 750
+// Shortest and longest time between two switch-ons which is still considered blinking
+#define BLINK_PERIOD_MIN 200
+#define BLINK_PERIOD_MAX 2000
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        /**
+         * @brief Tracks the on/off history of every led of the mainboard messages.
+         * For each led the time of the last change and the blink period (time between two consecutive
+         * switch-on edges) are kept, which makes an update O(1) per led regardless of the blink frequency.
+         *
+         * The blink period of the play/pause led is learned with a running average. A led is considered blinking
+         * as long as its last change is less than 3/4 of that period ago, i.e. 1.5 times the time between two changes,
+         * and the change before was not longer ago than that either. A led which is switched on once is not blinking.
+         */
+        class LedTracker
+        {
+        public:
+            /**
+             * @brief Feeds the led bytes of a mainboard message
+             *
+             * @param data mainboard message (19 bytes)
+             * @param now time at which the message has been received
+             */
+            void update(const uint8_t *data, uint32_t now)
+            {
+                for (std::size_t i = 0; i < LED_COUNT; i++)
+                {
+                    LedHistory &led = leds_[i];
+                    bool lit = is_lit(LED_OFFSET + i, data[LED_OFFSET + i]);
+                    if (lit == led.lit)
+                        continue;
+
+                    if (lit)
+                    {
+                        uint32_t period = now - led.last_rise;
+                        led.period = (led.last_rise != 0 && period <= BLINK_PERIOD_MAX) ? period : 0;
+                        led.last_rise = now;
+
+                        if (i == LED_PLAY_PAUSE - LED_OFFSET && led.period >= BLINK_PERIOD_MIN)
+                            learn_period(led.period);
+                    }
+                    led.lit = lit;
+                    led.previous_change = led.last_change;
+                    led.last_change = now;
+                }
+            }
+
+            /**
+             * @brief Treats a led as if it has just been blinking
+             *
+             * @param index byte index within the mainboard message (2 to 16)
+             * @param now current time
+             */
+            void restart(std::size_t index, uint32_t now)
+            {
+                leds_[index - LED_OFFSET].previous_change = now;
+                leds_[index - LED_OFFSET].last_change = now;
+            }
+
+            /**
+             * @brief Determines if a led has changed at least twice within the blink threshold
+             *
+             * @param index byte index within the mainboard message (2 to 16)
+             * @param now current time
+             */
+            bool is_blinking(std::size_t index, uint32_t now) const
+            {
+                const LedHistory &led = leds_[index - LED_OFFSET];
+                return now - led.last_change < blink_threshold_ && led.last_change - led.previous_change < blink_threshold_;
+            }
+
+            /**
+             * @brief Current activity of a led
+             *
+             * @param index byte index within the mainboard message (2 to 16)
+             * @param now current time
+             */
+            LedActivity activity(std::size_t index, uint32_t now) const
+            {
+                if (is_blinking(index, now))
+                    return LED_ACTIVITY_BLINKING;
+                return leds_[index - LED_OFFSET].lit ? LED_ACTIVITY_ON : LED_ACTIVITY_OFF;
+            }
+
+            /**
+             * @brief Most recently measured blink period of a led
+             *
+             * @param index byte index within the mainboard message (2 to 16)
+             * @param now current time
+             * @return period in ms, 0 if the led is not blinking or no full period has been observed yet
+             */
+            uint16_t period(std::size_t index, uint32_t now) const
+            {
+                return is_blinking(index, now) ? leds_[index - LED_OFFSET].period : 0;
+            }
+
+            /**
+             * @brief Learned blink period of the play/pause led
+             *
+             * @return period in ms, 0 if no period has been observed yet
+             */
+            uint16_t learned_period() const
+            {
+                return learned_period_;
+            }
+
+            /**
+             * @brief Time after a change during which a led is considered blinking
+             */
+            uint32_t blink_threshold() const
+            {
+                return blink_threshold_;
+            }
+
+        private:
+            /**
+             * @brief Determines if a led byte counts as switched on.
+             * The play/pause and size leds keep the comparison of the status qualifiers, a change between full and
+             * reduced brightness counts as blinking. Every other led is on at any brightness.
+             *
+             * @param index byte index within the mainboard message (2 to 16)
+             * @param value led byte
+             */
+            static bool is_lit(std::size_t index, uint8_t value)
+            {
+                if (index == LED_PLAY_PAUSE || index == LED_SIZE)
+                    return value == led_on;
+                return value != led_off;
+            }
+
+            /**
+             * @brief Updates the running estimate of the blink period
+             *
+             * @param period measured time between two switch-ons in ms
+             */
+            void learn_period(uint16_t period)
+            {
+                if (learned_period_ == 0)
+                    learned_period_ = period;
+                else
+                    learned_period_ = learned_period_ + ((int32_t)period - (int32_t)learned_period_) / 4;
+                blink_threshold_ = learned_period_ * 3 / 4;
+            }
+
+            /// @brief History of a single led
+            struct LedHistory
+            {
+                /// @brief whether the led is currently lit
+                bool lit = false;
+                /// @brief time of the last on/off change
+                uint32_t last_change = 0;
+                /// @brief time of the on/off change before the last one
+                uint32_t previous_change = 0;
+                /// @brief time of the last switch-on
+                uint32_t last_rise = 0;
+                /// @brief time between the last two switch-ons in ms
+                uint16_t period = 0;
+            };
+
+            /// @brief history of every led
+            LedHistory leds_[LED_COUNT];
+
+            /// @brief running average of the play/pause blink period in ms
+            uint16_t learned_period_ = 0;
+
+            /// @brief time after a change during which a led is considered blinking
+            uint32_t blink_threshold_ = BLINK_THRESHOLD;
+        };
+
+    } // namespace philips_coffee_machine
+} // namespace esphome
@@ -1,5 +1,5 @@
 #pragma once
-#include <string>
+#include "machine_state.h"
 
 namespace esphome
 {
@@ -8,203 +8,297 @@ namespace esphome
 #if defined(PHILIPS_COFFEE_LANG_en_US)
 #define PHILIPS_COFFEE_LANG_DEFAULT
 #elif defined(PHILIPS_COFFEE_LANG_de_DE)
-        const std::string state_unknown = "Unbekannt";
-        const std::string state_off = "Aus";
-        const std::string state_idle = "Bereit";
-        const std::string state_cleaning = "Spült";
-        const std::string state_preparing = "Vorbereitung";
-        const std::string state_water_empty = "Wasser leer";
-        const std::string state_waste_warning = "Abfallcontainerwarnung";
-        const std::string state_error = "Fehler";
-        const std::string state_internal_error = "Interner Fehler";
-
-        const std::string state_ground_coffee_selected = "Vorgemahlener Kaffee ausgewählt";
-        const std::string state_coffee_programming_mode = "Kaffee Programmiermodus ausgewählt";
-        const std::string state_coffee_selected = "Kaffee ausgewählt";
-        const std::string state_coffee_2x_selected = "2x Kaffee ausgewählt";
-        const std::string state_coffee_brewing = "Bereitet Kaffee zu";
-        const std::string state_coffee_2x_brewing = "Bereitet 2x Kaffee zu";
-
-        const std::string state_ground_espresso_selected = "Vorgemahlener Espresso ausgewählt";
-        const std::string state_espresso_programming_mode = "Espresso Programmiermodus ausgewählt";
-        const std::string state_espresso_selected = "Espresso ausgewählt";
-        const std::string state_espresso_2x_selected = "2x Espresso ausgewählt";
-        const std::string state_espresso_brewing = "Bereitet Espresso zu";
-        const std::string state_espresso_2x_brewing = "Bereitet 2x Espresso zu";
-
-        const std::string state_ground_americano_selected = "Vorgemahlener Americano ausgewählt";
-        const std::string state_americano_programming_mode = "Americano Programmiermodus ausgewählt";
-        const std::string state_americano_selected = "Americano ausgewählt";
-        const std::string state_americano_2x_selected = "2x Americano ausgewählt";
-        const std::string state_americano_brewing = "Bereitet Americano zu";
-        const std::string state_americano_2x_brewing = "Bereitet 2x Americano zu";
-
-        const std::string state_ground_cappuccino_selected = "Vorgemahlener Cappuccino ausgewählt";
-        const std::string state_cappuccino_programming_mode = "Cappuccino Programmiermodus ausgewählt";
-        const std::string state_cappuccino_selected = "Cappuccino ausgewählt";
-        const std::string state_cappuccino_brewing = "Bereitet Cappuccino zu";
-
-        const std::string state_ground_latte_selected = "Vorgemahlener Latte macchiato ausgewählt";
-        const std::string state_latte_programming_mode = "Latte macchiato Programmiermodus ausgewählt";
-        const std::string state_latte_selected = "Latte macchiato ausgewählt";
-        const std::string state_latte_brewing = "Bereitet Latte macchiato zu";
-
-        const std::string state_hot_water_programming_mode = "Heißes Wasser Programmiermodus ausgewählt";
-        const std::string state_hot_water_selected = "Heißes Wasser ausgewählt";
-        const std::string state_hot_water_brewing = "Bereitet heißes Wasser zu";
-
-        const std::string state_steam_selected = "Dampf ausgewählt";
-        const std::string state_steam_brewing = "Bereitet Dampf zu";
+        constexpr const char *state_unknown = "Unbekannt";
+        constexpr const char *state_off = "Aus";
+        constexpr const char *state_idle = "Bereit";
+        constexpr const char *state_cleaning = "Spült";
+        constexpr const char *state_preparing = "Vorbereitung";
+        constexpr const char *state_water_empty = "Wasser leer";
+        constexpr const char *state_waste_warning = "Abfallcontainerwarnung";
+        constexpr const char *state_error = "Fehler";
+        constexpr const char *state_internal_error = "Interner Fehler";
+
+        constexpr const char *state_ground_coffee_selected = "Vorgemahlener Kaffee ausgewählt";
+        constexpr const char *state_coffee_programming_mode = "Kaffee Programmiermodus ausgewählt";
+        constexpr const char *state_coffee_selected = "Kaffee ausgewählt";
+        constexpr const char *state_coffee_2x_selected = "2x Kaffee ausgewählt";
+        constexpr const char *state_coffee_brewing = "Bereitet Kaffee zu";
+        constexpr const char *state_coffee_2x_brewing = "Bereitet 2x Kaffee zu";
+
+        constexpr const char *state_ground_espresso_selected = "Vorgemahlener Espresso ausgewählt";
+        constexpr const char *state_espresso_programming_mode = "Espresso Programmiermodus ausgewählt";
+        constexpr const char *state_espresso_selected = "Espresso ausgewählt";
+        constexpr const char *state_espresso_2x_selected = "2x Espresso ausgewählt";
+        constexpr const char *state_espresso_brewing = "Bereitet Espresso zu";
+        constexpr const char *state_espresso_2x_brewing = "Bereitet 2x Espresso zu";
+
+        constexpr const char *state_ground_americano_selected = "Vorgemahlener Americano ausgewählt";
+        constexpr const char *state_americano_programming_mode = "Americano Programmiermodus ausgewählt";
+        constexpr const char *state_americano_selected = "Americano ausgewählt";
+        constexpr const char *state_americano_2x_selected = "2x Americano ausgewählt";
+        constexpr const char *state_americano_brewing = "Bereitet Americano zu";
+        constexpr const char *state_americano_2x_brewing = "Bereitet 2x Americano zu";
+
+        constexpr const char *state_ground_cappuccino_selected = "Vorgemahlener Cappuccino ausgewählt";
+        constexpr const char *state_cappuccino_programming_mode = "Cappuccino Programmiermodus ausgewählt";
+        constexpr const char *state_cappuccino_selected = "Cappuccino ausgewählt";
+        constexpr const char *state_cappuccino_brewing = "Bereitet Cappuccino zu";
+
+        constexpr const char *state_ground_latte_selected = "Vorgemahlener Latte macchiato ausgewählt";
+        constexpr const char *state_latte_programming_mode = "Latte macchiato Programmiermodus ausgewählt";
+        constexpr const char *state_latte_selected = "Latte macchiato ausgewählt";
+        constexpr const char *state_latte_brewing = "Bereitet Latte macchiato zu";
+
+        constexpr const char *state_hot_water_programming_mode = "Heißes Wasser Programmiermodus ausgewählt";
+        constexpr const char *state_hot_water_selected = "Heißes Wasser ausgewählt";
+        constexpr const char *state_hot_water_brewing = "Bereitet heißes Wasser zu";
+
+        constexpr const char *state_steam_selected = "Dampf ausgewählt";
+        constexpr const char *state_steam_brewing = "Bereitet Dampf zu";
 
 #elif defined(PHILIPS_COFFEE_LANG_it_IT)
-        const std::string state_unknown = "Sconosciuto";
-        const std::string state_off = "Spento";
-        const std::string state_idle = "In Attesa";
-        const std::string state_cleaning = "Pulizia";
-        const std::string state_preparing = "Preparazione";
-        const std::string state_water_empty = "Serbatoio Acqua Vuoto";
-        const std::string state_waste_warning = "Attenzione Contenitore Fondi Caffè";
-        const std::string state_error = "Errore";
-        const std::string state_internal_error = "Errore interno";
-
-        const std::string state_ground_coffee_selected = "Selezionato Caffè Premacinato";
-        const std::string state_coffee_programming_mode = "Selezionata Modalità programmazione Caffè";
-        const std::string state_coffee_selected = "Selezionato Caffè";
-        const std::string state_coffee_2x_selected = "Selezionati 2 Caffè";
-        const std::string state_coffee_brewing = "Erogazione Caffè";
-        const std::string state_coffee_2x_brewing = "Erogazione 2 Caffè";
-
-        const std::string state_ground_espresso_selected = "Selezionate Espresso Premacinato";
-        const std::string state_espresso_programming_mode = "Selezionata Modalità programmazione Espresso";
-        const std::string state_espresso_selected = "Selezionato Espresso";
-        const std::string state_espresso_2x_selected = "Selezionat1 2 Espressi";
-        const std::string state_espresso_brewing = "Erogazione Espresso";
-        const std::string state_espresso_2x_brewing = "Erogazione 2 Espressi";
-
-        const std::string state_ground_americano_selected = "Selezionato Americano Premacinato";
-        const std::string state_americano_programming_mode = "Selezionata Modalità programmazione Americano";
-        const std::string state_americano_selected = "Selezionato Americano";
-        const std::string state_americano_2x_selected = "Selezionati 2 Americani";
-        const std::string state_americano_brewing = "Erogazione Americano";
-        const std::string state_americano_2x_brewing = "Erogazione 2 Americani";
-
-        const std::string state_ground_cappuccino_selected = "Selezionato Cappuccino Premacinato";
-        const std::string state_cappuccino_programming_mode = "Selezionata Modalità programmazione Cappuccino";
-        const std::string state_cappuccino_selected = "Selezionato Cappuccino";
-        const std::string state_cappuccino_brewing = "Erogazione Cappuccino";
-
-        const std::string state_ground_latte_selected = "Selezionato Latte Macchiato Premacinato";
-        const std::string state_latte_programming_mode = "Selezionata Modalità programmazione Latte Macchiato";
-        const std::string state_latte_selected = "Selezionato Latte Macchiato";
-        const std::string state_latte_brewing = "Erogazione Latte Macchiato";
-
-        const std::string state_hot_water_programming_mode = "Selezionata Modalità programmazione Acqua Calda";
-        const std::string state_hot_water_selected = "Selezionata Acqua Calda";
-        const std::string state_hot_water_brewing = "Erogazione Acqua Calda";
-
-        const std::string state_steam_selected = "Vapore Selezionato";
-        const std::string state_steam_brewing = "Erogazione Vapore";
+        constexpr const char *state_unknown = "Sconosciuto";
+        constexpr const char *state_off = "Spento";
+        constexpr const char *state_idle = "In Attesa";
+        constexpr const char *state_cleaning = "Pulizia";
+        constexpr const char *state_preparing = "Preparazione";
+        constexpr const char *state_water_empty = "Serbatoio Acqua Vuoto";
+        constexpr const char *state_waste_warning = "Attenzione Contenitore Fondi Caffè";
+        constexpr const char *state_error = "Errore";
+        constexpr const char *state_internal_error = "Errore interno";
+
+        constexpr const char *state_ground_coffee_selected = "Selezionato Caffè Premacinato";
+        constexpr const char *state_coffee_programming_mode = "Selezionata Modalità programmazione Caffè";
+        constexpr const char *state_coffee_selected = "Selezionato Caffè";
+        constexpr const char *state_coffee_2x_selected = "Selezionati 2 Caffè";
+        constexpr const char *state_coffee_brewing = "Erogazione Caffè";
+        constexpr const char *state_coffee_2x_brewing = "Erogazione 2 Caffè";
+
+        constexpr const char *state_ground_espresso_selected = "Selezionate Espresso Premacinato";
+        constexpr const char *state_espresso_programming_mode = "Selezionata Modalità programmazione Espresso";
+        constexpr const char *state_espresso_selected = "Selezionato Espresso";
+        constexpr const char *state_espresso_2x_selected = "Selezionat1 2 Espressi";
+        constexpr const char *state_espresso_brewing = "Erogazione Espresso";
+        constexpr const char *state_espresso_2x_brewing = "Erogazione 2 Espressi";
+
+        constexpr const char *state_ground_americano_selected = "Selezionato Americano Premacinato";
+        constexpr const char *state_americano_programming_mode = "Selezionata Modalità programmazione Americano";
+        constexpr const char *state_americano_selected = "Selezionato Americano";
+        constexpr const char *state_americano_2x_selected = "Selezionati 2 Americani";
+        constexpr const char *state_americano_brewing = "Erogazione Americano";
+        constexpr const char *state_americano_2x_brewing = "Erogazione 2 Americani";
+
+        constexpr const char *state_ground_cappuccino_selected = "Selezionato Cappuccino Premacinato";
+        constexpr const char *state_cappuccino_programming_mode = "Selezionata Modalità programmazione Cappuccino";
+        constexpr const char *state_cappuccino_selected = "Selezionato Cappuccino";
+        constexpr const char *state_cappuccino_brewing = "Erogazione Cappuccino";
+
+        constexpr const char *state_ground_latte_selected = "Selezionato Latte Macchiato Premacinato";
+        constexpr const char *state_latte_programming_mode = "Selezionata Modalità programmazione Latte Macchiato";
+        constexpr const char *state_latte_selected = "Selezionato Latte Macchiato";
+        constexpr const char *state_latte_brewing = "Erogazione Latte Macchiato";
+
+        constexpr const char *state_hot_water_programming_mode = "Selezionata Modalità programmazione Acqua Calda";
+        constexpr const char *state_hot_water_selected = "Selezionata Acqua Calda";
+        constexpr const char *state_hot_water_brewing = "Erogazione Acqua Calda";
+
+        constexpr const char *state_steam_selected = "Vapore Selezionato";
+        constexpr const char *state_steam_brewing = "Erogazione Vapore";
 
 #elif defined(PHILIPS_COFFEE_LANG_hu_HU)
-        const std::string state_unknown = "Ismeretlen";
-        const std::string state_off = "Kikapcsolva";
-        const std::string state_idle = "Készenlét";
-        const std::string state_cleaning = "Öblítés";
-        const std::string state_preparing = "Előkészítés";
-        const std::string state_water_empty = "Víztartály üres";
-        const std::string state_waste_warning = "Zacctartály megtelt";
-        const std::string state_error = "Hiba";
-        const std::string state_internal_error = "Belső hiba";
-
-        const std::string state_ground_coffee_selected = "Őrölt kávé kiválasztva";
-        const std::string state_coffee_programming_mode = "Kávé programozási mód kiválasztva";
-        const std::string state_coffee_selected = "Kávé kiválasztva";
-        const std::string state_coffee_2x_selected = "2x kávé kiválasztva";
-        const std::string state_coffee_brewing = "Kávé készítése";
-        const std::string state_coffee_2x_brewing = "2x kávé készítése";
-
-        const std::string state_ground_espresso_selected = "Őrölt eszpresszó kiválasztva";
-        const std::string state_espresso_programming_mode = "Eszpresszó programozási mód kiválasztva";
-        const std::string state_espresso_selected = "Eszpresszó kiválasztva";
-        const std::string state_espresso_2x_selected = "2x eszpresszó kiválasztva";
-        const std::string state_espresso_brewing = "Eszpresszó készítése";
-        const std::string state_espresso_2x_brewing = "2x eszpresszó készítése";
-
-        const std::string state_ground_americano_selected = "Őrölt americano kiválasztva";
-        const std::string state_americano_programming_mode = "Americano programozási mód kiválasztva";
-        const std::string state_americano_selected = "Americano kiválasztva";
-        const std::string state_americano_2x_selected = "2x americano kiválasztva";
-        const std::string state_americano_brewing = "Americano készítése";
-        const std::string state_americano_2x_brewing = "2x americano készítése";
-
-        const std::string state_ground_cappuccino_selected = "Őrölt cappuccino kiválasztva";
-        const std::string state_cappuccino_programming_mode = "Cappuccino programozási mód kiválasztva";
-        const std::string state_cappuccino_selected = "Cappuccino kiválasztva";
-        const std::string state_cappuccino_brewing = "Cappuccino készítése";
-
-        const std::string state_ground_latte_selected = "Őrölt latte macchiato kiválasztva";
-        const std::string state_latte_programming_mode = "Latte macchiato programozási mód kiválasztva";
-        const std::string state_latte_selected = "Latte macchiato kiválasztva";
-        const std::string state_latte_brewing = "Latte macchiato készítése";
-
-        const std::string state_hot_water_programming_mode = "Forró víz programozási mód kiválasztva";
-        const std::string state_hot_water_selected = "Forró víz kiválasztva";
-        const std::string state_hot_water_brewing = "Forró víz készítése";
-
-        const std::string state_steam_selected = "Gőz kiválasztva";
-        const std::string state_steam_brewing = "Gőz készítése";
+        constexpr const char *state_unknown = "Ismeretlen";
+        constexpr const char *state_off = "Kikapcsolva";
+        constexpr const char *state_idle = "Készenlét";
+        constexpr const char *state_cleaning = "Öblítés";
+        constexpr const char *state_preparing = "Előkészítés";
+        constexpr const char *state_water_empty = "Víztartály üres";
+        constexpr const char *state_waste_warning = "Zacctartály megtelt";
+        constexpr const char *state_error = "Hiba";
+        constexpr const char *state_internal_error = "Belső hiba";
+
+        constexpr const char *state_ground_coffee_selected = "Őrölt kávé kiválasztva";
+        constexpr const char *state_coffee_programming_mode = "Kávé programozási mód kiválasztva";
+        constexpr const char *state_coffee_selected = "Kávé kiválasztva";
+        constexpr const char *state_coffee_2x_selected = "2x kávé kiválasztva";
+        constexpr const char *state_coffee_brewing = "Kávé készítése";
+        constexpr const char *state_coffee_2x_brewing = "2x kávé készítése";
+
+        constexpr const char *state_ground_espresso_selected = "Őrölt eszpresszó kiválasztva";
+        constexpr const char *state_espresso_programming_mode = "Eszpresszó programozási mód kiválasztva";
+        constexpr const char *state_espresso_selected = "Eszpresszó kiválasztva";
+        constexpr const char *state_espresso_2x_selected = "2x eszpresszó kiválasztva";
+        constexpr const char *state_espresso_brewing = "Eszpresszó készítése";
+        constexpr const char *state_espresso_2x_brewing = "2x eszpresszó készítése";
+
+        constexpr const char *state_ground_americano_selected = "Őrölt americano kiválasztva";
+        constexpr const char *state_americano_programming_mode = "Americano programozási mód kiválasztva";
+        constexpr const char *state_americano_selected = "Americano kiválasztva";
+        constexpr const char *state_americano_2x_selected = "2x americano kiválasztva";
+        constexpr const char *state_americano_brewing = "Americano készítése";
+        constexpr const char *state_americano_2x_brewing = "2x americano készítése";
+
+        constexpr const char *state_ground_cappuccino_selected = "Őrölt cappuccino kiválasztva";
+        constexpr const char *state_cappuccino_programming_mode = "Cappuccino programozási mód kiválasztva";
+        constexpr const char *state_cappuccino_selected = "Cappuccino kiválasztva";
+        constexpr const char *state_cappuccino_brewing = "Cappuccino készítése";
+
+        constexpr const char *state_ground_latte_selected = "Őrölt latte macchiato kiválasztva";
+        constexpr const char *state_latte_programming_mode = "Latte macchiato programozási mód kiválasztva";
+        constexpr const char *state_latte_selected = "Latte macchiato kiválasztva";
+        constexpr const char *state_latte_brewing = "Latte macchiato készítése";
+
+        constexpr const char *state_hot_water_programming_mode = "Forró víz programozási mód kiválasztva";
+        constexpr const char *state_hot_water_selected = "Forró víz kiválasztva";
+        constexpr const char *state_hot_water_brewing = "Forró víz készítése";
+
+        constexpr const char *state_steam_selected = "Gőz kiválasztva";
+        constexpr const char *state_steam_brewing = "Gőz készítése";
 #else
 #define PHILIPS_COFFEE_LANG_DEFAULT
 #endif
 
 #ifdef PHILIPS_COFFEE_LANG_DEFAULT
-        const std::string state_unknown = "Unknown";
-        const std::string state_off = "Off";
-        const std::string state_idle = "Idle";
-        const std::string state_cleaning = "Cleaning";
-        const std::string state_preparing = "Preparing";
-        const std::string state_water_empty = "Water empty";
-        const std::string state_waste_warning = "Waste container warning";
-        const std::string state_error = "Error";
-        const std::string state_internal_error = "Internal Error";
-
-        const std::string state_ground_coffee_selected = "Pre-ground Coffee selected";
-        const std::string state_coffee_programming_mode = "Coffee programming mode selected";
-        const std::string state_coffee_selected = "Coffee selected";
-        const std::string state_coffee_2x_selected = "2x Coffee selected";
-        const std::string state_coffee_brewing = "Brewing Coffee";
-        const std::string state_coffee_2x_brewing = "Brewing 2x Coffee";
-
-        const std::string state_ground_espresso_selected = "Pre-ground Espresso selected";
-        const std::string state_espresso_programming_mode = "Espresso programming mode selected";
-        const std::string state_espresso_selected = "Espresso selected";
-        const std::string state_espresso_2x_selected = "2x Espresso selected";
-        const std::string state_espresso_brewing = "Brewing Espresso";
-        const std::string state_espresso_2x_brewing = "Brewing 2x Espresso";
-
-        const std::string state_ground_americano_selected = "Pre-ground Americano selected";
-        const std::string state_americano_programming_mode = "Americano programming mode selected";
-        const std::string state_americano_selected = "Americano selected";
-        const std::string state_americano_2x_selected = "2x Americano selected";
-        const std::string state_americano_brewing = "Brewing Americano";
-        const std::string state_americano_2x_brewing = "Brewing 2x Americano";
-
-        const std::string state_ground_cappuccino_selected = "Pre-ground Cappuccino selected";
-        const std::string state_cappuccino_programming_mode = "Cappuccino programming mode selected";
-        const std::string state_cappuccino_selected = "Cappuccino selected";
-        const std::string state_cappuccino_brewing = "Brewing Cappuccino";
-
-        const std::string state_ground_latte_selected = "Pre-ground Latte Macchiato selected";
-        const std::string state_latte_programming_mode = "Latte Macchiato programming mode selected";
-        const std::string state_latte_selected = "Latte Macchiato selected";
-        const std::string state_latte_brewing = "Brewing Latte Macchiato";
-
-        const std::string state_hot_water_programming_mode = "Hot water programming mode selected";
-        const std::string state_hot_water_selected = "Hot water selected";
-        const std::string state_hot_water_brewing = "Making Hot Water";
-
-        const std::string state_steam_selected = "Steam selected";
-        const std::string state_steam_brewing = "Making Steam";
+        constexpr const char *state_unknown = "Unknown";
+        constexpr const char *state_off = "Off";
+        constexpr const char *state_idle = "Idle";
+        constexpr const char *state_cleaning = "Cleaning";
+        constexpr const char *state_preparing = "Preparing";
+        constexpr const char *state_water_empty = "Water empty";
+        constexpr const char *state_waste_warning = "Waste container warning";
+        constexpr const char *state_error = "Error";
+        constexpr const char *state_internal_error = "Internal Error";
+
+        constexpr const char *state_ground_coffee_selected = "Pre-ground Coffee selected";
+        constexpr const char *state_coffee_programming_mode = "Coffee programming mode selected";
+        constexpr const char *state_coffee_selected = "Coffee selected";
+        constexpr const char *state_coffee_2x_selected = "2x Coffee selected";
+        constexpr const char *state_coffee_brewing = "Brewing Coffee";
+        constexpr const char *state_coffee_2x_brewing = "Brewing 2x Coffee";
+
+        constexpr const char *state_ground_espresso_selected = "Pre-ground Espresso selected";
+        constexpr const char *state_espresso_programming_mode = "Espresso programming mode selected";
+        constexpr const char *state_espresso_selected = "Espresso selected";
+        constexpr const char *state_espresso_2x_selected = "2x Espresso selected";
+        constexpr const char *state_espresso_brewing = "Brewing Espresso";
+        constexpr const char *state_espresso_2x_brewing = "Brewing 2x Espresso";
+
+        constexpr const char *state_ground_americano_selected = "Pre-ground Americano selected";
+        constexpr const char *state_americano_programming_mode = "Americano programming mode selected";
+        constexpr const char *state_americano_selected = "Americano selected";
+        constexpr const char *state_americano_2x_selected = "2x Americano selected";
+        constexpr const char *state_americano_brewing = "Brewing Americano";
+        constexpr const char *state_americano_2x_brewing = "Brewing 2x Americano";
+
+        constexpr const char *state_ground_cappuccino_selected = "Pre-ground Cappuccino selected";
+        constexpr const char *state_cappuccino_programming_mode = "Cappuccino programming mode selected";
+        constexpr const char *state_cappuccino_selected = "Cappuccino selected";
+        constexpr const char *state_cappuccino_brewing = "Brewing Cappuccino";
+
+        constexpr const char *state_ground_latte_selected = "Pre-ground Latte Macchiato selected";
+        constexpr const char *state_latte_programming_mode = "Latte Macchiato programming mode selected";
+        constexpr const char *state_latte_selected = "Latte Macchiato selected";
+        constexpr const char *state_latte_brewing = "Brewing Latte Macchiato";
+
+        constexpr const char *state_hot_water_programming_mode = "Hot water programming mode selected";
+        constexpr const char *state_hot_water_selected = "Hot water selected";
+        constexpr const char *state_hot_water_brewing = "Making Hot Water";
+
+        constexpr const char *state_steam_selected = "Steam selected";
+        constexpr const char *state_steam_brewing = "Making Steam";
 #endif
+
+        /**
+         * @brief Localized text of a machine state, only used for publishing
+         *
+         * @param state machine state
+         */
+        inline const char *state_text(MachineState state)
+        {
+            switch (state)
+            {
+            case MachineState::UNKNOWN:
+                return state_unknown;
+            case MachineState::OFF:
+                return state_off;
+            case MachineState::IDLE:
+                return state_idle;
+            case MachineState::CLEANING:
+                return state_cleaning;
+            case MachineState::PREPARING:
+                return state_preparing;
+            case MachineState::WATER_EMPTY:
+                return state_water_empty;
+            case MachineState::WASTE_WARNING:
+                return state_waste_warning;
+            case MachineState::ERROR:
+                return state_error;
+            case MachineState::INTERNAL_ERROR:
+                return state_internal_error;
+            case MachineState::GROUND_COFFEE_SELECTED:
+                return state_ground_coffee_selected;
+            case MachineState::COFFEE_PROGRAMMING_MODE:
+                return state_coffee_programming_mode;
+            case MachineState::COFFEE_SELECTED:
+                return state_coffee_selected;
+            case MachineState::COFFEE_2X_SELECTED:
+                return state_coffee_2x_selected;
+            case MachineState::COFFEE_BREWING:
+                return state_coffee_brewing;
+            case MachineState::COFFEE_2X_BREWING:
+                return state_coffee_2x_brewing;
+            case MachineState::GROUND_ESPRESSO_SELECTED:
+                return state_ground_espresso_selected;
+            case MachineState::ESPRESSO_PROGRAMMING_MODE:
+                return state_espresso_programming_mode;
+            case MachineState::ESPRESSO_SELECTED:
+                return state_espresso_selected;
+            case MachineState::ESPRESSO_2X_SELECTED:
+                return state_espresso_2x_selected;
+            case MachineState::ESPRESSO_BREWING:
+                return state_espresso_brewing;
+            case MachineState::ESPRESSO_2X_BREWING:
+                return state_espresso_2x_brewing;
+            case MachineState::GROUND_AMERICANO_SELECTED:
+                return state_ground_americano_selected;
+            case MachineState::AMERICANO_PROGRAMMING_MODE:
+                return state_americano_programming_mode;
+            case MachineState::AMERICANO_SELECTED:
+                return state_americano_selected;
+            case MachineState::AMERICANO_2X_SELECTED:
+                return state_americano_2x_selected;
+            case MachineState::AMERICANO_BREWING:
+                return state_americano_brewing;
+            case MachineState::AMERICANO_2X_BREWING:
+                return state_americano_2x_brewing;
+            case MachineState::GROUND_CAPPUCCINO_SELECTED:
+                return state_ground_cappuccino_selected;
+            case MachineState::CAPPUCCINO_PROGRAMMING_MODE:
+                return state_cappuccino_programming_mode;
+            case MachineState::CAPPUCCINO_SELECTED:
+                return state_cappuccino_selected;
+            case MachineState::CAPPUCCINO_BREWING:
+                return state_cappuccino_brewing;
+            case MachineState::GROUND_LATTE_SELECTED:
+                return state_ground_latte_selected;
+            case MachineState::LATTE_PROGRAMMING_MODE:
+                return state_latte_programming_mode;
+            case MachineState::LATTE_SELECTED:
+                return state_latte_selected;
+            case MachineState::LATTE_BREWING:
+                return state_latte_brewing;
+            case MachineState::HOT_WATER_PROGRAMMING_MODE:
+                return state_hot_water_programming_mode;
+            case MachineState::HOT_WATER_SELECTED:
+                return state_hot_water_selected;
+            case MachineState::HOT_WATER_BREWING:
+                return state_hot_water_brewing;
+            case MachineState::STEAM_SELECTED:
+                return state_steam_selected;
+            case MachineState::STEAM_BREWING:
+                return state_steam_brewing;
+            default:
+                return state_unknown;
+            }
+        }
     } // namespace philips_coffee_machine
 } // namespace esphome
@@ -0,0 +1,123 @@
+#include <algorithm>
+
+#include "machine_decoder.h"
+#include "status_rules.h"
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        /**
+         * @brief Decodes a beverage setting level
+         *
+         * @param enable led which indicates that the setting is shown
+         * @param amount led which shows the amount
+         */
+        static uint8_t decode_level(uint8_t enable, uint8_t amount)
+        {
+            if (enable != led_on)
+                return LEVEL_HIDDEN;
+
+            switch (amount)
+            {
+            case led_off:
+                return 1;
+            case led_second:
+                return 2;
+            case led_third:
+                return 3;
+            default:
+                return LEVEL_UNKNOWN;
+            }
+        }
+
+        const MachineSnapshot &MachineDecoder::decode(const uint8_t *data, uint32_t now)
+        {
+            // Check which leds are on/off/blinking
+            leds_.update(data, now);
+
+            snapshot_.time = now;
+
+            // The mainboard turns off every led once the machine has been switched off, no need to wait for the display to fall silent
+            if (std::all_of(data + LED_OFFSET, data + LED_OFFSET + LED_COUNT, [](uint8_t led) { return led == led_off; }))
+            {
+                set_off();
+                return snapshot_;
+            }
+
+            std::copy(data + LED_OFFSET, data + LED_OFFSET + LED_COUNT, snapshot_.leds.begin());
+            for (std::size_t i = 0; i < LED_COUNT; i++)
+            {
+                snapshot_.activity[i] = leds_.activity(LED_OFFSET + i, now);
+                snapshot_.blink_period[i] = leds_.period(LED_OFFSET + i, now);
+            }
+            snapshot_.play_pause_blinking = snapshot_.led_activity(LED_PLAY_PAUSE) == LED_ACTIVITY_BLINKING;
+            snapshot_.size_changed = snapshot_.led_activity(LED_SIZE) == LED_ACTIVITY_BLINKING;
+
+            snapshot_.bean_level = decode_level(data[9], data[8]);
+            snapshot_.size_level = decode_level(data[11], data[10]);
+            snapshot_.milk_level = decode_level(data[11], data[13]);
+
+            snapshot_.errors = ERROR_NONE;
+            if (data[14] == led_second)
+                snapshot_.errors |= ERROR_WATER_EMPTY;
+            if (data[15] == led_on)
+                snapshot_.errors |= ERROR_WASTE_CONTAINER;
+            if (data[15] == led_second)
+                snapshot_.errors |= ERROR_GENERAL;
+
+            uint8_t qualifiers = snapshot_.play_pause_blinking ? QUALIFIER_BLINKING : QUALIFIER_STEADY;
+            if (snapshot_.size_changed)
+                qualifiers |= QUALIFIER_SIZE_CHANGED;
+
+            const StatusRule *rule = find_status_rule(load_led_words(data), qualifiers);
+            if (rule == nullptr)
+            {
+                snapshot_.frame_state = MachineState::UNKNOWN;
+                return snapshot_;
+            }
+
+            // selecting a beverage can result in a short "busy" period since the play/pause button has not been blinking
+            // This can be circumvented: if the user is on the selection screen/idle we can reset the timer
+            if (rule->state == MachineState::IDLE)
+                leds_.restart(LED_PLAY_PAUSE, now);
+
+            snapshot_.frame_state = rule->state;
+            debounce(rule->state, now);
+            return snapshot_;
+        }
+
+        void MachineDecoder::debounce(MachineState state, uint32_t now)
+        {
+            if (state != new_state_)
+            {
+                new_state_ = state;
+                new_state_since_ = now;
+            }
+
+            if (state != snapshot_.state && now - new_state_since_ >= settle_times_[state_class(state)])
+                snapshot_.state = state;
+        }
+
+        bool MachineDecoder::set_off()
+        {
+            // The frame state and leds are reset even if Off has already been published, a new state may be settling
+            bool changed = snapshot_.state != MachineState::OFF;
+            snapshot_.state = MachineState::OFF;
+            snapshot_.frame_state = MachineState::OFF;
+            // The next state has to settle again once the display is back
+            new_state_ = MachineState::OFF;
+            snapshot_.leds.fill(led_off);
+            snapshot_.activity.fill(LED_ACTIVITY_OFF);
+            snapshot_.blink_period.fill(0);
+            snapshot_.play_pause_blinking = false;
+            snapshot_.size_changed = false;
+            snapshot_.bean_level = LEVEL_HIDDEN;
+            snapshot_.size_level = LEVEL_HIDDEN;
+            snapshot_.milk_level = LEVEL_HIDDEN;
+            snapshot_.errors = ERROR_NONE;
+            return changed;
+        }
+
+    } // namespace philips_coffee_machine
+} // namespace esphome
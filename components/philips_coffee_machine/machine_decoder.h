@@ -0,0 +1,98 @@
+#pragma once
+
+#include <stdint.h>
+#include "led_tracker.h"
+#include "machine_snapshot.h"
+
+// Time a new state has to be decoded continuously before it is published, per state class.
+// Feel free to lower these, you might get some invalid intermittent state though
+#define SETTLE_TIME_ERROR 100
+#define SETTLE_TIME_STEADY 300
+#define SETTLE_TIME_SELECTION 750
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        /**
+         * @brief Decodes mainboard messages into snapshots.
+         * Keeps the led history required for blink detection and debounces the machine state.
+         */
+        class MachineDecoder
+        {
+        public:
+            /**
+             * @brief Sets the time a state of the given class has to be decoded continuously before it is published
+             *
+             * @param state_class state class
+             * @param time settle time in ms
+             */
+            void set_settle_time(StateClass state_class, uint32_t time)
+            {
+                settle_times_[state_class] = time;
+            }
+
+            /**
+             * @brief Decodes a mainboard message.
+             * A message with all leds turned off immediately results in the Off state.
+             *
+             * @param data mainboard message (19 bytes)
+             * @param now time at which the message has been received
+             * @return updated snapshot
+             */
+            const MachineSnapshot &decode(const uint8_t *data, uint32_t now);
+
+            /**
+             * @brief Sets the state to Off, either since the display is no longer requesting messages
+             * or since the mainboard has turned off all leds
+             *
+             * @return true if the published state has changed
+             */
+            bool set_off();
+
+            /**
+             * @brief The most recent snapshot
+             */
+            const MachineSnapshot &snapshot() const
+            {
+                return snapshot_;
+            }
+
+            /**
+             * @brief Learned blink period of the play/pause led
+             *
+             * @return period in ms, 0 if no period has been observed yet
+             */
+            uint16_t blink_period() const
+            {
+                return leds_.learned_period();
+            }
+
+        private:
+            /**
+             * @brief Debounces a decoded state, the snapshot state only changes once a state has been
+             * decoded continuously for the settle time of its class
+             *
+             * @param state state decoded from the current message
+             * @param now time at which the message has been received
+             */
+            void debounce(MachineState state, uint32_t now);
+
+            /// @brief the most recent snapshot
+            MachineSnapshot snapshot_;
+
+            /// @brief settle time in ms per state class
+            uint32_t settle_times_[STATE_CLASS_COUNT] = {SETTLE_TIME_ERROR, SETTLE_TIME_STEADY, SETTLE_TIME_SELECTION};
+
+            /// @brief state which has been decoded most recently
+            MachineState new_state_ = MachineState::UNKNOWN;
+
+            /// @brief time since which new_state_ has been decoded continuously
+            uint32_t new_state_since_ = 0;
+
+            /// @brief on/off history of all leds
+            LedTracker leds_;
+        };
+
+    } // namespace philips_coffee_machine
+} // namespace esphome
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdint.h>
+#include "commands.h"
+#include "machine_state.h"
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        /// @brief index of the first LED byte within a mainboard frame
+        static constexpr std::size_t LED_OFFSET = 2;
+
+        /// @brief number of LED bytes within a mainboard frame
+        static constexpr std::size_t LED_COUNT = MAINBOARD_FRAME_SIZE - LED_OFFSET - CHECKSUM_SIZE;
+
+        /// @brief index of the size led, blinks in programming mode
+        static constexpr std::size_t LED_SIZE = 11;
+
+        /// @brief index of the play/pause led, blinks while a beverage is selected
+        static constexpr std::size_t LED_PLAY_PAUSE = 16;
+
+        /**
+         * @brief Bit of a led within a led mask
+         *
+         * @param index byte index within the mainboard message (2 to 16)
+         */
+        constexpr uint16_t led_bit(std::size_t index)
+        {
+            return 1 << (index - LED_OFFSET);
+        }
+
+        /// @brief every led, power messages turn all leds on or off
+        static constexpr uint16_t LEDS_ALL = (1 << LED_COUNT) - 1;
+
+        /// @brief drink selection leds (including the rotating icons)
+        static constexpr uint16_t LEDS_DRINK = led_bit(3) | led_bit(4) | led_bit(5) | led_bit(6) | led_bit(7);
+
+        /// @brief bean level and ground coffee leds
+        static constexpr uint16_t LEDS_BEAN = led_bit(8) | led_bit(9);
+
+        /// @brief size level leds
+        static constexpr uint16_t LEDS_SIZE = led_bit(10) | led_bit(LED_SIZE);
+
+        /// @brief milk level leds
+        static constexpr uint16_t LEDS_MILK = led_bit(LED_SIZE) | led_bit(13);
+
+        /// @brief leds which change once brewing starts, the selection turns into the rotating icons
+        static constexpr uint16_t LEDS_BREW = LEDS_DRINK | led_bit(LED_PLAY_PAUSE);
+
+        /// @brief beverage setting level if the setting is not shown on the display
+        static constexpr uint8_t LEVEL_HIDDEN = 0;
+
+        /// @brief beverage setting level if the setting is shown but its led value is not known
+        static constexpr uint8_t LEVEL_UNKNOWN = 0xFF;
+
+        /**
+         * @brief Activity of a single led
+         */
+        enum LedActivity : uint8_t
+        {
+            LED_ACTIVITY_OFF = 0,
+            LED_ACTIVITY_ON,
+            LED_ACTIVITY_BLINKING,
+        };
+
+        /**
+         * @brief Warning leds
+         */
+        enum MachineError : uint8_t
+        {
+            ERROR_NONE = 0,
+            ERROR_WATER_EMPTY = 1 << 0,
+            ERROR_WASTE_CONTAINER = 1 << 1,
+            ERROR_GENERAL = 1 << 2,
+        };
+
+        /**
+         * @brief Everything which has been decoded from a single mainboard message.
+         * The controller decodes every message once and passes the snapshot to all entities.
+         */
+        struct MachineSnapshot
+        {
+            /// @brief debounced machine state
+            MachineState state = MachineState::UNKNOWN;
+
+            /// @brief state decoded from this message alone
+            MachineState frame_state = MachineState::UNKNOWN;
+
+            /// @brief led bytes 2 to 16 of the message
+            std::array<uint8_t, LED_COUNT> leds = {};
+
+            /// @brief on/off/blinking state of every led
+            std::array<LedActivity, LED_COUNT> activity = {};
+
+            /// @brief blink period of every led in ms, 0 if the led is not blinking
+            std::array<uint16_t, LED_COUNT> blink_period = {};
+
+            /// @brief whether the play/pause led has changed recently
+            bool play_pause_blinking = false;
+
+            /// @brief whether the size led has changed recently (programming mode)
+            bool size_changed = false;
+
+            /// @brief selected bean amount (1-3)
+            uint8_t bean_level = LEVEL_HIDDEN;
+
+            /// @brief selected size (1-3)
+            uint8_t size_level = LEVEL_HIDDEN;
+
+            /// @brief selected milk amount (1-3)
+            uint8_t milk_level = LEVEL_HIDDEN;
+
+            /// @brief active warning leds (MachineError)
+            uint8_t errors = ERROR_NONE;
+
+            /// @brief time at which the message has been received
+            uint32_t time = 0;
+
+            /**
+             * @brief Value of a single led byte
+             *
+             * @param index byte index within the mainboard message (2 to 16)
+             */
+            uint8_t led(std::size_t index) const
+            {
+                return leds[index - LED_OFFSET];
+            }
+
+            /**
+             * @brief Activity of a single led
+             *
+             * @param index byte index within the mainboard message (2 to 16)
+             */
+            LedActivity led_activity(std::size_t index) const
+            {
+                return activity[index - LED_OFFSET];
+            }
+
+            /**
+             * @brief Blink period of a single led
+             *
+             * @param index byte index within the mainboard message (2 to 16)
+             * @return period in ms, 0 if the led is not blinking
+             */
+            uint16_t led_period(std::size_t index) const
+            {
+                return blink_period[index - LED_OFFSET];
+            }
+
+            /**
+             * @brief Determines if a drink can be selected, i.e. the machine is idle or shows a selection.
+             * Both the debounced and the current state have to agree, since the debounced state lags behind after brewing started.
+             */
+            bool is_ready() const
+            {
+                return (state == MachineState::IDLE || state_class(state) == STATE_CLASS_SELECTION) &&
+                       (frame_state == MachineState::IDLE || state_class(frame_state) == STATE_CLASS_SELECTION);
+            }
+        };
+
+    } // namespace philips_coffee_machine
+} // namespace esphome
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        /**
+         * @brief States of the coffee machine as decoded from the mainboard messages.
+         * Localized text is only derived when a state is published (see state_text()).
+         */
+        enum class MachineState : uint8_t
+        {
+            UNKNOWN,
+            OFF,
+            IDLE,
+            CLEANING,
+            PREPARING,
+            WATER_EMPTY,
+            WASTE_WARNING,
+            ERROR,
+            INTERNAL_ERROR,
+            GROUND_COFFEE_SELECTED,
+            COFFEE_PROGRAMMING_MODE,
+            COFFEE_SELECTED,
+            COFFEE_2X_SELECTED,
+            COFFEE_BREWING,
+            COFFEE_2X_BREWING,
+            GROUND_ESPRESSO_SELECTED,
+            ESPRESSO_PROGRAMMING_MODE,
+            ESPRESSO_SELECTED,
+            ESPRESSO_2X_SELECTED,
+            ESPRESSO_BREWING,
+            ESPRESSO_2X_BREWING,
+            GROUND_AMERICANO_SELECTED,
+            AMERICANO_PROGRAMMING_MODE,
+            AMERICANO_SELECTED,
+            AMERICANO_2X_SELECTED,
+            AMERICANO_BREWING,
+            AMERICANO_2X_BREWING,
+            GROUND_CAPPUCCINO_SELECTED,
+            CAPPUCCINO_PROGRAMMING_MODE,
+            CAPPUCCINO_SELECTED,
+            CAPPUCCINO_BREWING,
+            GROUND_LATTE_SELECTED,
+            LATTE_PROGRAMMING_MODE,
+            LATTE_SELECTED,
+            LATTE_BREWING,
+            HOT_WATER_PROGRAMMING_MODE,
+            HOT_WATER_SELECTED,
+            HOT_WATER_BREWING,
+            STEAM_SELECTED,
+            STEAM_BREWING,
+        };
+
+        /**
+         * @brief Groups of states which share a debounce settle time
+         */
+        enum StateClass : uint8_t
+        {
+            /// @brief warnings and errors, published quickly
+            STATE_CLASS_ERROR = 0,
+            /// @brief idle, off and brewing/cleaning states
+            STATE_CLASS_STEADY,
+            /// @brief selection and programming states, which depend on blink detection and flicker during transitions
+            STATE_CLASS_SELECTION,
+            STATE_CLASS_COUNT,
+        };
+
+        /**
+         * @brief Determines the settle time class of a state
+         *
+         * @param state machine state
+         */
+        constexpr StateClass state_class(MachineState state)
+        {
+            switch (state)
+            {
+            case MachineState::WATER_EMPTY:
+            case MachineState::WASTE_WARNING:
+            case MachineState::ERROR:
+            case MachineState::INTERNAL_ERROR:
+                return STATE_CLASS_ERROR;
+            case MachineState::GROUND_COFFEE_SELECTED:
+            case MachineState::COFFEE_PROGRAMMING_MODE:
+            case MachineState::COFFEE_SELECTED:
+            case MachineState::COFFEE_2X_SELECTED:
+            case MachineState::GROUND_ESPRESSO_SELECTED:
+            case MachineState::ESPRESSO_PROGRAMMING_MODE:
+            case MachineState::ESPRESSO_SELECTED:
+            case MachineState::ESPRESSO_2X_SELECTED:
+            case MachineState::GROUND_AMERICANO_SELECTED:
+            case MachineState::AMERICANO_PROGRAMMING_MODE:
+            case MachineState::AMERICANO_SELECTED:
+            case MachineState::AMERICANO_2X_SELECTED:
+            case MachineState::GROUND_CAPPUCCINO_SELECTED:
+            case MachineState::CAPPUCCINO_PROGRAMMING_MODE:
+            case MachineState::CAPPUCCINO_SELECTED:
+            case MachineState::GROUND_LATTE_SELECTED:
+            case MachineState::LATTE_PROGRAMMING_MODE:
+            case MachineState::LATTE_SELECTED:
+            case MachineState::HOT_WATER_PROGRAMMING_MODE:
+            case MachineState::HOT_WATER_SELECTED:
+            case MachineState::STEAM_SELECTED:
+                return STATE_CLASS_SELECTION;
+            default:
+                return STATE_CLASS_STEADY;
+            }
+        }
+
+    } // namespace philips_coffee_machine
+} // namespace esphome
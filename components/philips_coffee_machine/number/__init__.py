@@ -53,7 +53,8 @@ CONFIG_SCHEMA = cv.All(
     ).extend(
         {
             cv.Required(CONTROLLER_ID): cv.use_id(PhilipsCoffeeMachine),
-            cv.Required(STATUS_SENSOR_ID): cv.use_id(StatusSensor),
+            # The machine state is decoded by the controller, the status sensor is no longer required
+            cv.Optional(STATUS_SENSOR_ID): cv.use_id(StatusSensor),
             cv.Required(CONF_TYPE): cv.enum(TYPES, upper=True, space="_"),
             cv.Optional(CONF_MODE, default="SLIDER"): cv.enum(
                 number.NUMBER_MODES, upper=True
@@ -78,10 +79,8 @@ async def to_code(config):
     await cg.register_component(var, config)
     
     parent = await cg.get_variable(config[CONTROLLER_ID])
-    status_sensor = await cg.get_variable(config[STATUS_SENSOR_ID])
 
     cg.add(var.set_type(config[CONF_TYPE]))
     cg.add(var.set_source(config[CONF_SOURCE]))
-    cg.add(var.set_status_sensor(status_sensor))
     cg.add(var.set_restore_value(config[CONF_RESTORE_VALUE]))
     cg.add(parent.add_beverage_setting(var))
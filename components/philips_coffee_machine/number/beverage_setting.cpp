@@ -40,28 +40,24 @@ namespace esphome
                 // Apply restored value when machine becomes idle after power-on
                 if (restore_value_ && !restored_value_applied_ && !std::isnan(restored_value_))
                 {
-                    if (status_sensor_->has_state())
+                    // Wait for machine to be idle or ready before applying restored value
+                    if (machine_state_ == MachineState::IDLE)
                     {
-                        std::string status = status_sensor_->get_raw_state();
-                        // Wait for machine to be idle or ready before applying restored value
-                        if (status.compare(state_idle) == 0)
+                        // Give the machine a moment to stabilize after reaching idle
+                        // Check if we have a current state and it doesn't match
+                        if (!std::isnan(this->state) && this->state != restored_value_)
                         {
-                            // Give the machine a moment to stabilize after reaching idle
-                            // Check if we have a current state and it doesn't match
-                            if (!std::isnan(this->state) && this->state != restored_value_)
-                            {
-                                ESP_LOGI(TAG, "Applying restored value: %.0f (current: %.0f)", restored_value_, this->state);
-                                target_amount_ = (int8_t)restored_value_;
-                                restored_value_applied_ = true;
-                            }
-                            else if (!std::isnan(this->state) && this->state == restored_value_)
-                            {
-                                // Value already matches, no need to apply
-                                ESP_LOGI(TAG, "Value already matches restored value: %.0f", restored_value_);
-                                restored_value_applied_ = true;
-                            }
-                            // If state is still NAN, keep trying next loop
+                            ESP_LOGI(TAG, "Applying restored value: %.0f (current: %.0f)", restored_value_, this->state);
+                            set_target((int8_t)restored_value_);
+                            restored_value_applied_ = true;
                         }
+                        else if (!std::isnan(this->state) && this->state == restored_value_)
+                        {
+                            // Value already matches, no need to apply
+                            ESP_LOGI(TAG, "Value already matches restored value: %.0f", restored_value_);
+                            restored_value_applied_ = true;
+                        }
+                        // If state is still NAN, keep trying next loop
                     }
                 }
             }
@@ -74,18 +70,18 @@ namespace esphome
 
             void BeverageSetting::control(float value)
             {
-                target_amount_ = (std::isnan(value) || std::isnan(state)) ? -1 : value;
+                set_target((std::isnan(value) || std::isnan(state)) ? -1 : value);
             }
 
-            void BeverageSetting::update_status(uint8_t *data)
+            void BeverageSetting::update_status(const MachineSnapshot &snapshot)
             {
-
-                if (!status_sensor_->has_state())
+                MachineState status = snapshot.state;
+                if (status == MachineState::UNKNOWN)
                     return;
+                machine_state_ = status;
 
                 // Reset restored_value_applied when machine goes OFF so we reapply on next power-on
-                std::string status = status_sensor_->get_raw_state();
-                if (status.compare(state_off) == 0 && restored_value_applied_)
+                if (status == MachineState::OFF && restored_value_applied_)
                 {
                     restored_value_applied_ = false;
                     ESP_LOGD(TAG, "Machine OFF, will reapply restored value on next power-on");
@@ -93,77 +89,51 @@ namespace esphome
 
                 // only apply status if source is currently selected
                 if ((type_ != MILK && (source_ == COFFEE || source_ == ANY) &&
-                     (status.compare(state_coffee_selected) == 0 ||
-                      status.compare(state_coffee_2x_selected) == 0 ||
-                      (type_ != BEAN && status.compare(state_ground_coffee_selected) == 0))) ||
+                     (status == MachineState::COFFEE_SELECTED ||
+                      status == MachineState::COFFEE_2X_SELECTED ||
+                      (type_ != BEAN && status == MachineState::GROUND_COFFEE_SELECTED))) ||
                     (type_ != MILK && (source_ == ESPRESSO || source_ == ANY) &&
-                     (status.compare(state_espresso_selected) == 0 ||
-                      status.compare(state_espresso_2x_selected) == 0 ||
-                      (type_ != BEAN && status.compare(state_ground_espresso_selected) == 0))) ||
+                     (status == MachineState::ESPRESSO_SELECTED ||
+                      status == MachineState::ESPRESSO_2X_SELECTED ||
+                      (type_ != BEAN && status == MachineState::GROUND_ESPRESSO_SELECTED))) ||
                     (type_ != MILK && (source_ == AMERICANO || source_ == ANY) &&
-                     (status.compare(state_americano_selected) == 0 ||
-                      status.compare(state_americano_2x_selected) == 0 ||
-                      (type_ != BEAN && status.compare(state_ground_americano_selected) == 0))) ||
+                     (status == MachineState::AMERICANO_SELECTED ||
+                      status == MachineState::AMERICANO_2X_SELECTED ||
+                      (type_ != BEAN && status == MachineState::GROUND_AMERICANO_SELECTED))) ||
                     ((source_ == CAPPUCCINO || source_ == ANY) &&
-                     (status.compare(state_cappuccino_selected) == 0 ||
-                      (type_ != BEAN && status.compare(state_ground_cappuccino_selected) == 0))) ||
+                     (status == MachineState::CAPPUCCINO_SELECTED ||
+                      (type_ != BEAN && status == MachineState::GROUND_CAPPUCCINO_SELECTED))) ||
                     ((source_ == LATTE_MACCHIATO || source_ == ANY) &&
-                     (status.compare(state_latte_selected) == 0 ||
-                      (type_ != BEAN && status.compare(state_ground_latte_selected) == 0))) ||
+                     (status == MachineState::LATTE_SELECTED ||
+                      (type_ != BEAN && status == MachineState::GROUND_LATTE_SELECTED))) ||
                     (type_ != BEAN && type_ != MILK && (source_ == HOT_WATER || source_ == ANY) &&
-                     status.compare(state_hot_water_selected) == 0))
+                     status == MachineState::HOT_WATER_SELECTED))
                 {
-                    uint8_t enable_byte = type_ == BEAN ? 9 : 11;
-                    uint8_t amount_byte = type_ == BEAN ? 8 : (type_ == SIZE ? 10 : 13);
+                    uint8_t level = type_ == BEAN ? snapshot.bean_level : (type_ == SIZE ? snapshot.size_level : snapshot.milk_level);
 
-                    if (data[enable_byte] == led_on)
+                    if (level != LEVEL_HIDDEN)
                     {
-                        switch (data[amount_byte])
+                        if (level != LEVEL_UNKNOWN)
+                            update_state(level);
+
+                        // The level is confirmed by the mainboard messages, another burst is only sent if it does not match
+                        if (target_amount_ != -1 && level == target_amount_)
                         {
-                        case led_off:
-                            update_state(1);
-                            break;
-                        case led_second:
-                            update_state(2);
-                            break;
-                        case led_third:
-                            update_state(3);
-                            break;
-                        default:
-                            break;
+                            ESP_LOGD(TAG, "Reached level %d after %d press burst(s)", target_amount_, burst_count_);
+                            set_target(-1);
                         }
-
-                        // press the size/bean button until the target value has been reached
-                        if (target_amount_ != -1 && state != target_amount_ && millis() - last_transmission_ > SETTINGS_BUTTON_SEQUENCE_DELAY)
+                        else if (target_amount_ != -1 && level != LEVEL_UNKNOWN &&
+                                 (burst_count_ == 0 || (millis() - burst_start_ >= burst_duration_ && bus_->queue_depth() == 0)))
                         {
-                            for (unsigned int i = 0; i <= MESSAGE_REPETITIONS; i++)
+                            if (burst_count_ < SETTINGS_MAX_BURSTS)
                             {
-                                switch (type_)
-                                {
-                                case BEAN:
-                                    mainboard_uart_->write_array(command_press_bean);
-                                    break;
-                                case SIZE:
-                                    mainboard_uart_->write_array(command_press_size);
-                                    break;
-#ifdef PHILIPS_EP3243
-                                case MILK:
-                                    mainboard_uart_->write_array(command_press_milk);
-                                    break;
-#endif
-                                default:
-                                    break;
-                                }
+                                send_press_burst(level);
+                            }
+                            else
+                            {
+                                ESP_LOGW(TAG, "Level %d not reached after %d press bursts, giving up", target_amount_, burst_count_);
+                                set_target(-1);
                             }
-
-                            mainboard_uart_->flush();
-                            last_transmission_ = millis();
-                        }
-
-                        // Unset the target state to allow for manual control
-                        if (state == target_amount_)
-                        {
-                            target_amount_ = -1;
                         }
 
                         return;
@@ -175,6 +145,46 @@ namespace esphome
                 update_state(NAN);
             }
 
+            void BeverageSetting::send_press_burst(uint8_t level)
+            {
+                const Command *command = nullptr;
+                uint16_t ack_leds = 0;
+                switch (type_)
+                {
+                case BEAN:
+                    command = &command_press_bean;
+                    ack_leds = LEDS_BEAN;
+                    break;
+                case SIZE:
+                    command = &command_press_size;
+                    ack_leds = LEDS_SIZE;
+                    break;
+#ifdef PHILIPS_EP3243
+                case MILK:
+                    command = &command_press_milk;
+                    ack_leds = LEDS_MILK;
+                    break;
+#endif
+                default:
+                    break;
+                }
+                if (command == nullptr)
+                {
+                    set_target(-1);
+                    return;
+                }
+
+                // Every press advances the level by one, wrapping around after the highest level
+                uint8_t presses = (target_amount_ - level + SETTING_LEVEL_COUNT) % SETTING_LEVEL_COUNT;
+                ESP_LOGD(TAG, "Pressing %d time(s) to get from level %d to %d", presses, level, target_amount_);
+                for (uint8_t i = 0; i < presses; i++)
+                    bus_->enqueue(*command, TX_PRIORITY_SETTING, MESSAGE_REPETITIONS, i == 0 ? 0 : SETTINGS_PRESS_GAP, ack_leds);
+
+                burst_count_++;
+                burst_start_ = millis();
+                burst_duration_ = presses * SETTINGS_PRESS_GAP + SETTINGS_BUTTON_SEQUENCE_DELAY;
+            }
+
         } // namespace philips_beverage_setting
     }     // namespace philips_coffee_machine
 } // namespace esphome
\ No newline at end of file
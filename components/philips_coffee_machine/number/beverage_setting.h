@@ -3,12 +3,18 @@
 #include "esphome/core/component.h"
 #include "esphome/core/preferences.h"
 #include "esphome/components/number/number.h"
-#include "esphome/components/uart/uart.h"
-#include "../text_sensor/status_sensor.h"
+#include "../bus_arbiter.h"
 #include "../commands.h"
+#include "../machine_snapshot.h"
 
 #define MESSAGE_REPETITIONS 5
+// Time after the last press of a burst within which the new level has to be reported
 #define SETTINGS_BUTTON_SEQUENCE_DELAY 500
+// Pause between two presses of a burst, the mainboard has to see display messages in between
+#define SETTINGS_PRESS_GAP 150
+#define SETTINGS_MAX_BURSTS 3
+// Levels cycle through 1 -> 2 -> 3 -> 1
+#define SETTING_LEVEL_COUNT 3
 
 namespace esphome
 {
@@ -81,22 +87,13 @@ namespace esphome
                 };
 
                 /**
-                 * @brief Sets the status sensor reference
-                 * @param status_sensor text sensor reference
-                 */
-                void set_status_sensor(philips_status_sensor::StatusSensor *status_sensor)
-                {
-                    status_sensor_ = status_sensor;
-                }
-
-                /**
-                 * @brief Reference to uart which is connected to the mainboard
+                 * @brief Reference to the arbiter of the mainboard bus
                  *
-                 * @param uart uart connected to mainboard
+                 * @param bus bus arbiter
                  */
-                void set_uart_device(uart::UARTDevice *uart)
+                void set_bus(BusArbiter *bus)
                 {
-                    mainboard_uart_ = uart;
+                    bus_ = bus;
                 };
 
                 /**
@@ -122,28 +119,52 @@ namespace esphome
 
                 /**
                  * @brief Updates the sensor value based on the incoming messages.
-                 * @param data incoming data from the motherboard (19 bytes)
+                 * @param snapshot decoded mainboard message
                  */
-                void update_status(uint8_t *data);
+                void update_status(const MachineSnapshot &snapshot);
 
             private:
+                /**
+                 * @brief Sets a new target level and allows the full number of press bursts to reach it
+                 *
+                 * @param target target level, -1 to stop controlling the level
+                 */
+                void set_target(int8_t target)
+                {
+                    target_amount_ = target;
+                    burst_count_ = 0;
+                }
+
+                /**
+                 * @brief Enqueues all presses required to get from the current level to the target level
+                 *
+                 * @param level current level
+                 */
+                void send_press_burst(uint8_t level);
+
                 /// @brief Setting type to which this component applies
                 Type type_ = BEAN;
 
                 /// @brief Indicator for the sensors source value
                 Source source_;
 
-                /// @brief reference to uart connected to mainboard
-                uart::UARTDevice *mainboard_uart_;
+                /// @brief arbiter of the mainboard bus
+                BusArbiter *bus_;
 
                 /// @brief User selected target amount
                 int8_t target_amount_ = -1;
 
-                /// @brief timestamp of the last transmission
-                uint32_t last_transmission_ = 0;
+                /// @brief time at which the last press burst has been enqueued
+                uint32_t burst_start_ = 0;
+
+                /// @brief time in ms within which the level of the last press burst has to be reported
+                uint32_t burst_duration_ = 0;
+
+                /// @brief nr of press bursts sent for the current target
+                uint8_t burst_count_ = 0;
 
-                /// @brief reference to a status sensor
-                philips_status_sensor::StatusSensor *status_sensor_;
+                /// @brief machine state of the latest decoded message
+                MachineState machine_state_ = MachineState::UNKNOWN;
                 
                 /// @brief whether to restore last known value on startup
                 bool restore_value_ = false;
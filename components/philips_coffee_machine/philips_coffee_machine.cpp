@@ -7,9 +7,6 @@ namespace esphome
 {
     namespace philips_coffee_machine
     {
-        static constexpr std::size_t MAINBOARD_BUFFER_SIZE = 19;
-        static constexpr std::size_t DISPLAY_BUFFER_SIZE = 12;
-
         static const char *TAG = "philips_coffee_machine";
 
         void PhilipsCoffeeMachine::setup()
@@ -22,140 +19,272 @@ namespace esphome
             ESP_LOGI(TAG, "With invert=%d and pin=%d, display should be: %s", 
                      invert_power_pin_, initial_pin_state_, 
                      (initial_pin_state_ == !invert_power_pin_) ? "POWERED" : "OFF");
+
+            if (bridge_task_ && !bridge_.start_task())
+                ESP_LOGW(TAG, "Bridge task could not be started, forwarding from the component loop");
+
             ESP_LOGI(TAG, "Setup complete - use 'Manual Power Trip' button in GUI to wake display if needed");
         }
 
         void PhilipsCoffeeMachine::loop()
         {
-            uint8_t display_buffer[DISPLAY_BUFFER_SIZE];
-            uint8_t mainboard_buffer[MAINBOARD_BUFFER_SIZE];
-            
-            // Pipe display to mainboard
-            if (display_uart_.available())
+#ifdef USE_SENSOR
+            uint32_t loop_start = micros();
+#endif
+            // Forward messages unless the bridge task takes care of it
+            if (!bridge_.is_task_running())
+                bridge_.poll();
+
+            MainboardFrame frame;
+            while (bridge_.pop_frame(frame))
+                process_mainboard_frame(frame.data());
+
+            // Send queued messages between the forwarded display messages
+            bus_.loop();
+
+            // New drinks are rejected while the machine is off, those still waiting are dropped once it turns off
+            if (drink_queue_.size() > 0 && decoder_.snapshot().state == MachineState::OFF)
             {
-                std::size_t size = std::min(display_uart_.available(), DISPLAY_BUFFER_SIZE);
-                display_uart_.read_array(display_buffer, size);
+                ESP_LOGW(TAG, "Machine is off, dropping %d queued drink(s)", drink_queue_.size());
+                drink_queue_.clear();
+            }
 
-                // Check if a action button is currently performing a long press
-                bool long_pressing = false;
-#ifdef USE_BUTTON
-                for (philips_action_button::ActionButton *button : action_buttons_)
-                {
-                    if (button->is_long_pressing())
-                    {
-                        long_pressing = true;
-                        break;
-                    }
-                }
-#endif
+            // The machine is off once the display stops requesting messages or the mainboard turns off all leds
+            // The bridge task may update the timestamp at any time, thus it has to be read before millis()
+            uint32_t last_message_from_display_time = bridge_.last_display_time();
+            bool display_active = millis() - last_message_from_display_time <= POWER_STATE_TIMEOUT;
+
+            // While the display is emulated the mainboard answers the status requests even without a display
+            if (bus_.is_emulating_display() && millis() - last_message_from_mainboard_time_ <= POWER_STATE_TIMEOUT)
+                display_active = true;
+            // The decoder is only reset once the display falls silent, nothing has to be done while it stays silent
+            if (display_active != display_active_)
+            {
+                display_active_ = display_active;
+                if (!display_active && decoder_.set_off())
+                    dispatch_snapshot(decoder_.snapshot());
+            }
 
-                // Check if power switch is injecting power-on commands
-                bool power_injecting = false;
+            // Only notify the power switches on changes, nothing has to be done while the machine is sleeping
+            bool powered = display_active && decoder_.snapshot().frame_state != MachineState::OFF;
+            if (powered != powered_)
+            {
+                powered_ = powered;
+                ESP_LOGD(TAG, "Machine powered %s", powered ? "on" : "off");
 #ifdef USE_SWITCH
                 for (philips_power_switch::Power *power_switch : power_switches_)
-                {
-                    if (power_switch->is_injecting_commands())
-                    {
-                        power_injecting = true;
-                        break;
-                    }
-                }
+                    power_switch->update_state(powered);
+#endif
+            }
+
+            // Writes are buffered by the uart, flushing only blocks the loop until they have been sent
+            bool display_tx_pending = bridge_.take_display_tx_pending();
+            bool mainboard_tx_pending = bus_.take_tx_pending();
+            if (flush_uarts_ && (display_tx_pending || mainboard_tx_pending))
+            {
+#ifdef USE_SENSOR
+                uint32_t flush_start = micros();
 #endif
+                if (display_tx_pending)
+                    display_uart_.flush();
+                if (mainboard_tx_pending)
+                    mainboard_uart_.flush();
+#ifdef USE_SENSOR
+                flush_time_sum_ += micros() - flush_start;
+#endif
+            }
 
-                // Block messages during automated sequences
-                // When doing automated power-on via GUI/phone, we block ALL display messages
-                // to ensure our commands reach the mainboard without interference
-                bool should_block = false;
-                if (long_pressing || power_injecting)
-                {
-                    should_block = true;  // Block all messages during automation
-                }
+#ifdef USE_SENSOR
+            uint32_t loop_time = micros() - loop_start;
+            loop_time_sum_ += loop_time;
+            loop_time_max_ = std::max(loop_time_max_, loop_time);
+            loop_count_++;
 
-                if (!should_block)
-                {
-                    mainboard_uart_.write_array(display_buffer, size);
-                }
-                last_message_from_display_time_ = millis();
+            if (millis() - last_diagnostic_update_ > DIAGNOSTIC_UPDATE_INTERVAL)
+            {
+                // Rates are computed over the time since the previous update
+                update_diagnostic_sensors();
+                last_diagnostic_update_ = millis();
             }
+#endif
+        }
 
-            // Read and forward until valid start bytes have been received
-            while (mainboard_uart_.available())
+        void PhilipsCoffeeMachine::process_mainboard_frame(const uint8_t *frame)
+        {
+            if (!is_valid_frame(frame, MAINBOARD_FRAME_SIZE))
             {
-                mainboard_buffer[0] = mainboard_uart_.read();
-                display_uart_.write(mainboard_buffer[0]);
-                if (mainboard_buffer[0] == message_header[0])
-                {
-                    mainboard_buffer[1] = mainboard_uart_.read();
-                    display_uart_.write(mainboard_buffer[1]);
-                    if (mainboard_buffer[1] == message_header[1])
-                    {
-                        break;
-                    }
-                }
+                ESP_LOGV(TAG, "Discarding mainboard frame with invalid checksum");
+                return;
+            }
+
+            last_message_from_mainboard_time_ = millis();
+#ifdef USE_SENSOR
+            mainboard_frame_count_++;
+#endif
+            dispatch_snapshot(decoder_.decode(frame, last_message_from_mainboard_time_));
+        }
+
+        bool PhilipsCoffeeMachine::make_drink(Drink drink, uint8_t bean_level, uint8_t size_level, uint8_t milk_level, bool ground)
+        {
+            Recipe recipe;
+            recipe.drink = drink;
+            recipe.bean_level = bean_level;
+            recipe.size_level = size_level;
+            recipe.milk_level = milk_level;
+            recipe.ground = ground;
+            if (!RecipeEngine::is_valid(recipe))
+                return false;
+
+            // The queue is only served while the machine is on, the request would be dropped silently
+            if (decoder_.snapshot().state == MachineState::OFF)
+            {
+                ESP_LOGW(TAG, "Machine is off, drink request rejected");
+                return false;
             }
 
-            // Pipe to display
-            if (mainboard_uart_.available())
+            if (!drink_queue_.push(recipe))
             {
-                std::size_t size = std::min(mainboard_uart_.available(), MAINBOARD_BUFFER_SIZE - 2);
-                mainboard_uart_.read_array(mainboard_buffer + 2, size);
+                ESP_LOGW(TAG, "Drink queue full, request dropped");
+                return false;
+            }
+            return true;
+        }
 
-                display_uart_.write_array(mainboard_buffer + 2, size);
+        void PhilipsCoffeeMachine::dispatch_snapshot(const MachineSnapshot &snapshot)
+        {
+            bus_.update_acknowledgement(snapshot);
+            recipe_engine_.update(snapshot);
+
+            // Start the next queued drink once the machine is ready again
+            if (!recipe_engine_.is_active())
+            {
+                Recipe recipe;
+                if (snapshot.is_ready() && drink_queue_.pop(recipe))
+                    recipe_engine_.start(recipe, snapshot);
+                else if (drink_queue_.size() == 0 && snapshot.state == MachineState::IDLE)
+                    drink_queue_.reset_position();
+            }
 
-                if (size >= MAINBOARD_BUFFER_SIZE - 2)
-                {
-                    // Only process messages starting with start bytes
-                    // Only process duplicate messages (crude checksum alternative)
-                    // TODO: figure out how the checksum is calculated and only parse valid messages
-                    if (mainboard_buffer[0] == message_header[0] &&
-                        mainboard_buffer[1] == message_header[1] &&
-                        std::equal(mainboard_buffer + 17, mainboard_buffer + 19, std::begin(last_mainboard_message_checksum_)))
-                    {
-                        last_message_from_mainboard_time_ = millis();
 #ifdef USE_TEXT_SENSOR
-                        // Update status sensors
-                        for (philips_status_sensor::StatusSensor *status_sensor : status_sensors_)
-                            status_sensor->update_status(mainboard_buffer);
+            // Update status sensors
+            for (philips_status_sensor::StatusSensor *status_sensor : status_sensors_)
+                status_sensor->update_status(snapshot);
+#endif
 
 #ifdef USE_NUMBER
-                        // Update beverage settings
-                        for (philips_beverage_setting::BeverageSetting *beverage_setting : beverage_settings_)
-                            beverage_setting->update_status(mainboard_buffer);
+            // Update beverage settings
+            for (philips_beverage_setting::BeverageSetting *beverage_setting : beverage_settings_)
+                beverage_setting->update_status(snapshot);
 #endif
+        }
+
+#ifdef USE_SENSOR
+        void PhilipsCoffeeMachine::update_diagnostic_sensors()
+        {
+            for (philips_diagnostic_sensor::DiagnosticSensor *diagnostic_sensor : diagnostic_sensors_)
+            {
+                switch (diagnostic_sensor->get_type())
+                {
+                case philips_diagnostic_sensor::TX_QUEUE_DEPTH:
+                    diagnostic_sensor->update_value(bus_.queue_depth());
+                    break;
+                case philips_diagnostic_sensor::TX_DROPPED:
+                    diagnostic_sensor->update_value(bus_.dropped_count());
+                    break;
+                case philips_diagnostic_sensor::LOOP_TIME:
+                    diagnostic_sensor->update_value(loop_time_sum_ / (float) loop_count_);
+                    break;
+                case philips_diagnostic_sensor::LOOP_TIME_MAX:
+                    diagnostic_sensor->update_value(loop_time_max_);
+                    break;
+                case philips_diagnostic_sensor::FLUSH_TIME:
+                    diagnostic_sensor->update_value(flush_time_sum_ / (float) loop_count_);
+                    break;
+                case philips_diagnostic_sensor::BLINK_PERIOD:
+                    diagnostic_sensor->update_value(decoder_.blink_period());
+                    break;
+                case philips_diagnostic_sensor::DRINK_QUEUE_LENGTH:
+                    diagnostic_sensor->update_value(drink_queue_.size());
+                    break;
+                case philips_diagnostic_sensor::DRINK_QUEUE_POSITION:
+                    diagnostic_sensor->update_value(drink_queue_.position());
+                    break;
+                case philips_diagnostic_sensor::ACK_SUCCESS_RATE:
+                    diagnostic_sensor->update_value(bus_.ack_success_rate());
+                    break;
+                case philips_diagnostic_sensor::ACK_FRAMES:
+                    diagnostic_sensor->update_value(bus_.ack_mean_frames());
+                    break;
+                case philips_diagnostic_sensor::CACHED_REPLIES:
+                    diagnostic_sensor->update_value(bridge_.cached_replies());
+                    break;
+                case philips_diagnostic_sensor::MAINBOARD_FRAME_RATE:
+                    diagnostic_sensor->update_value(mainboard_frame_count_ * 1000.0f / (millis() - last_diagnostic_update_));
+                    break;
+#ifdef USE_SWITCH
+                case philips_diagnostic_sensor::DISPLAY_BOOT_TIME:
+                case philips_diagnostic_sensor::POWER_TRIPS:
+                case philips_diagnostic_sensor::TIME_TO_IDLE:
+                case philips_diagnostic_sensor::POWER_ON_FAILURES:
+                    update_power_on_sensor(diagnostic_sensor);
+                    break;
 #endif
-                    }
-                    // retain last checksum for comparison with next checksum
-                    std::copy_n(mainboard_buffer + 17, 2, last_mainboard_message_checksum_);
+                default:
+                    break;
                 }
             }
 
-            // Publish power state if required as long as the display is requesting messages
-            if (millis() - last_message_from_display_time_ > POWER_STATE_TIMEOUT)
-            {
+            loop_count_ = 0;
+            loop_time_sum_ = 0;
+            loop_time_max_ = 0;
+            flush_time_sum_ = 0;
+            mainboard_frame_count_ = 0;
+        }
+
 #ifdef USE_SWITCH
-                // Update power switches
+        void PhilipsCoffeeMachine::update_power_on_sensor(philips_diagnostic_sensor::DiagnosticSensor *diagnostic_sensor)
+        {
+            // Failures are summed over all power switches, the other values are taken from the most recent attempt of any switch
+            if (diagnostic_sensor->get_type() == philips_diagnostic_sensor::POWER_ON_FAILURES)
+            {
+                uint32_t failures = 0;
                 for (philips_power_switch::Power *power_switch : power_switches_)
-                    power_switch->update_state(false);
-#endif
-
-#ifdef USE_TEXT_SENSOR
-                // Update status sensors
-                for (philips_status_sensor::StatusSensor *status_sensor : status_sensors_)
-                    status_sensor->set_state_off();
-#endif
+                    failures += power_switch->failed_power_on_attempts();
+                diagnostic_sensor->update_value(failures);
+                return;
             }
-            else
+
+            // Only report values which have actually been measured
+            uint32_t now = millis();
+            const philips_power_switch::PowerOnAttempt *attempt = nullptr;
+            for (philips_power_switch::Power *power_switch : power_switches_)
             {
-#ifdef USE_SWITCH
-                // Update power switches
-                for (philips_power_switch::Power *power_switch : power_switches_)
-                    power_switch->update_state(true);
-#endif
+                const philips_power_switch::PowerOnAttempt *candidate = power_switch->last_power_on_attempt();
+                if (candidate != nullptr && (attempt == nullptr || now - candidate->start < now - attempt->start))
+                    attempt = candidate;
             }
+            if (attempt == nullptr)
+                return;
 
-            display_uart_.flush();
-            mainboard_uart_.flush();
+            switch (diagnostic_sensor->get_type())
+            {
+            case philips_diagnostic_sensor::DISPLAY_BOOT_TIME:
+                if (attempt->boot_time > 0)
+                    diagnostic_sensor->update_value(attempt->boot_time);
+                break;
+            case philips_diagnostic_sensor::POWER_TRIPS:
+                diagnostic_sensor->update_value(attempt->trips);
+                break;
+            case philips_diagnostic_sensor::TIME_TO_IDLE:
+                if (attempt->idle_time > 0)
+                    diagnostic_sensor->update_value(attempt->idle_time);
+                break;
+            default:
+                break;
+            }
         }
+#endif
+#endif
 
         void PhilipsCoffeeMachine::dump_config()
         {
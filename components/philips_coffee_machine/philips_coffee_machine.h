@@ -2,21 +2,31 @@
 
 #include "esphome/core/component.h"
 #include "esphome/components/uart/uart.h"
+#include "bridge.h"
+#include "bus_arbiter.h"
+#include "checksum.h"
 #include "commands.h"
+#include "drink_queue.h"
+#include "machine_decoder.h"
+#include "recipe_engine.h"
 #ifdef USE_SWITCH
 #include "switch/power.h"
 #endif
 #ifdef USE_BUTTON
 #include "button/action_button.h"
 #endif
+#ifdef USE_SENSOR
+#include "sensor/diagnostic_sensor.h"
+#endif
 #ifdef USE_TEXT_SENSOR
 #include "text_sensor/status_sensor.h"
+#endif
 #ifdef USE_NUMBER
 #include "number/beverage_setting.h"
 #endif
-#endif
 
 #define POWER_STATE_TIMEOUT 500
+#define DIAGNOSTIC_UPDATE_INTERVAL 1000
 
 namespace esphome
 {
@@ -38,6 +48,7 @@ namespace esphome
             void register_display_uart(uart::UARTComponent *uart)
             {
                 display_uart_ = uart::UARTDevice(uart);
+                bridge_.setup(&display_uart_, &mainboard_uart_, &bus_);
             };
 
             /**
@@ -48,6 +59,9 @@ namespace esphome
             void register_mainboard_uart(uart::UARTComponent *uart)
             {
                 mainboard_uart_ = uart::UARTDevice(uart);
+                bus_.set_mainboard_uart(&mainboard_uart_);
+                recipe_engine_.set_bus(&bus_);
+                bridge_.setup(&display_uart_, &mainboard_uart_, &bus_);
             };
 
             /**
@@ -99,6 +113,50 @@ namespace esphome
                 power_message_repetitions_ = count;
             }
 
+            /**
+             * @brief Enables flushing the uarts after each loop iteration in which data has been written.
+             * Flushing blocks until the data has been sent, the bridge does not require it.
+             *
+             * @param flush true to flush after writes
+             */
+            void set_flush_uarts(bool flush)
+            {
+                flush_uarts_ = flush;
+            }
+
+            /**
+             * @brief Runs the display/mainboard forwarding in a dedicated task instead of the component loop.
+             * Only supported on the ESP32 (and the host platform), the component loop falls back to polling otherwise.
+             *
+             * @param bridge_task true to use a dedicated task
+             */
+            void set_bridge_task(bool bridge_task)
+            {
+                bridge_task_ = bridge_task;
+            }
+
+            /**
+             * @brief Enables the display emulation, in which status requests are sent to the mainboard by the controller.
+             * The machine can be run without a display or be polled faster than by the display.
+             *
+             * @param interval time between two status requests in ms, 0 to only rely on the display
+             */
+            void set_status_request_interval(uint32_t interval)
+            {
+                bus_.set_status_request_interval(interval);
+            }
+
+            /**
+             * @brief Sets the time a state has to be decoded continuously before it is published
+             *
+             * @param state_class class of states to which the time applies
+             * @param time settle time in ms
+             */
+            void set_settle_time(StateClass state_class, uint32_t time)
+            {
+                decoder_.set_settle_time(state_class, time);
+            }
+
             /**
              * @brief Get the power pin for manual control (testing)
              */
@@ -124,6 +182,28 @@ namespace esphome
              */
             bool get_pending_power_off() { return pending_power_off_; }
 
+            /**
+             * @brief Selects a drink, applies its settings and starts brewing once the mainboard confirms all of them.
+             * Returns immediately, the request is queued and prepared as soon as the machine is ready.
+             *
+             * @param drink drink to brew
+             * @param bean_level strength from 1 to 3, 0 keeps the current strength
+             * @param size_level size from 1 to 3, 0 keeps the current size
+             * @param milk_level amount of milk from 1 to 3, 0 keeps the current amount
+             * @param ground true if ground coffee is used instead of beans
+             * @return false if the recipe has been rejected, the machine is off or the queue is full
+             */
+            bool make_drink(Drink drink, uint8_t bean_level = 0, uint8_t size_level = 0, uint8_t milk_level = 0, bool ground = false);
+
+            /**
+             * @brief Stops the recipe which is currently prepared without brewing and drops all queued drinks
+             */
+            void cancel_drink()
+            {
+                drink_queue_.clear();
+                recipe_engine_.cancel();
+            }
+
 #ifdef USE_SWITCH
             /**
              * @brief Reference to a power switch object.
@@ -133,17 +213,14 @@ namespace esphome
              */
             void register_power_switch(philips_power_switch::Power *power_switch)
             {
-                power_switch->set_mainboard_uart(&mainboard_uart_);
+                power_switch->set_bus(&bus_);
                 power_switch->set_power_pin(power_pin_);
                 power_switch->set_power_trip_delay(power_trip_delay_);
                 power_switch->set_display_boot_delay(display_boot_delay_);
                 power_switch->set_invert_power_pin(invert_power_pin_);
                 power_switch->set_power_message_repetitions(power_message_repetitions_);
                 power_switch->set_initial_state(&initial_pin_state_);
-                // Pass status sensor reference if available (for detecting actual machine ON state)
-                if (!status_sensors_.empty()) {
-                    power_switch->set_status_sensor(status_sensors_[0]);
-                }
+                power_switch->set_machine_snapshot(&decoder_.snapshot());
                 power_switches_.push_back(power_switch);
             };
 #endif
@@ -151,17 +228,30 @@ namespace esphome
 #ifdef USE_BUTTON
             /**
              * @brief Adds an action button to this controller.
-             * No reference is stored, but the correct uart references is passed along.
+             * The bus arbiter reference is passed along.
              *
              * @param action_button Action button which will be added to this controller
              */
             void add_action_button(philips_action_button::ActionButton *action_button)
             {
-                action_button->set_uart_device(&mainboard_uart_);
+                action_button->set_bus(&bus_);
+                action_button->set_drink_queue(&drink_queue_);
+                action_button->set_machine_snapshot(&decoder_.snapshot());
                 action_buttons_.push_back(action_button);
             }
 #endif
 
+#ifdef USE_SENSOR
+            /**
+             * @brief Adds a diagnostic sensor to this controller
+             * @param diagnostic_sensor reference to a diagnostic sensor
+             */
+            void add_diagnostic_sensor(philips_diagnostic_sensor::DiagnosticSensor *diagnostic_sensor)
+            {
+                diagnostic_sensors_.push_back(diagnostic_sensor);
+            }
+#endif
+
 #ifdef USE_TEXT_SENSOR
             /**
              * @brief Adds a status sensor to this controller
@@ -171,6 +261,7 @@ namespace esphome
             {
                 status_sensors_.push_back(status_sensor);
             }
+#endif
 
 #ifdef USE_NUMBER
             /**
@@ -179,19 +270,62 @@ namespace esphome
              */
             void add_beverage_setting(philips_beverage_setting::BeverageSetting *beverage_setting)
             {
-                beverage_setting->set_uart_device(&mainboard_uart_);
+                beverage_setting->set_bus(&bus_);
                 beverage_settings_.push_back(beverage_setting);
             }
+#endif
+
+        private:
+            /**
+             * @brief Processes a completely reassembled mainboard frame
+             *
+             * @param frame mainboard frame (19 bytes)
+             */
+            void process_mainboard_frame(const uint8_t *frame);
+
+            /**
+             * @brief Passes a decoded mainboard message to all entities
+             *
+             * @param snapshot decoded mainboard message
+             */
+            void dispatch_snapshot(const MachineSnapshot &snapshot);
+
+#ifdef USE_SENSOR
+            /**
+             * @brief Publishes the current values of all diagnostic sensors
+             */
+            void update_diagnostic_sensors();
 
+#ifdef USE_SWITCH
+            /**
+             * @brief Publishes the outcome of the last power-on attempts of all power switches.
+             * Failures are summed, the other values are taken from the most recent attempt.
+             *
+             * @param diagnostic_sensor sensor reporting a power-on value
+             */
+            void update_power_on_sensor(philips_diagnostic_sensor::DiagnosticSensor *diagnostic_sensor);
 #endif
+
+            /// @brief time at which the diagnostic sensors were last updated
+            uint32_t last_diagnostic_update_ = 0;
+
+            /// @brief number of loop iterations since the last diagnostic update
+            uint32_t loop_count_ = 0;
+
+            /// @brief accumulated loop duration in us since the last diagnostic update
+            uint32_t loop_time_sum_ = 0;
+
+            /// @brief longest loop duration in us since the last diagnostic update
+            uint32_t loop_time_max_ = 0;
+
+            /// @brief accumulated time in us spent flushing since the last diagnostic update
+            uint32_t flush_time_sum_ = 0;
+
+            /// @brief number of valid mainboard messages since the last diagnostic update
+            uint32_t mainboard_frame_count_ = 0;
 #endif
 
-        private:
             uint32_t last_message_from_mainboard_time_ = 0;
-            uint32_t last_message_from_display_time_ = 0;
-
-            /// @brief the last received mainboard message checksum; new messages are compared to this as a kind of pseudo-checksum
-            uint8_t last_mainboard_message_checksum_[2] = {0x00};
 
             /// @brief reference to uart connected to the display unit
             uart::UARTDevice display_uart_;
@@ -199,6 +333,33 @@ namespace esphome
             /// @brief reference to uart connected to the mainboard
             uart::UARTDevice mainboard_uart_;
 
+            /// @brief arbiter owning the transmitting side of the mainboard uart
+            BusArbiter bus_;
+
+            /// @brief forwards messages between display and mainboard
+            Bridge bridge_;
+
+            /// @brief decodes mainboard messages once for all entities
+            MachineDecoder decoder_;
+
+            /// @brief power state which has last been passed to the power switches
+            bool powered_ = false;
+
+            /// @brief whether the display was active during the previous loop iteration, starts out active so that Off is published once at boot
+            bool display_active_ = true;
+
+            /// @brief prepares drinks requested by make_drink()
+            RecipeEngine recipe_engine_;
+
+            /// @brief drinks waiting for the machine to become ready
+            DrinkQueue drink_queue_;
+
+            /// @brief whether the bridge runs in a dedicated task
+            bool bridge_task_ = false;
+
+            /// @brief whether the uarts are flushed after writes
+            bool flush_uarts_ = false;
+
             /// @brief pin connect to display panel power transistor/mosfet
             GPIOPin *power_pin_;
 
@@ -225,15 +386,20 @@ namespace esphome
             std::vector<philips_power_switch::Power *> power_switches_;
 #endif
 
+#ifdef USE_SENSOR
+            /// @brief list of diagnostic sensors
+            std::vector<philips_diagnostic_sensor::DiagnosticSensor *> diagnostic_sensors_;
+#endif
+
 #ifdef USE_TEXT_SENSOR
             /// @brief list of status sensors to update with messages
             std::vector<philips_status_sensor::StatusSensor *> status_sensors_;
+#endif
 
 #ifdef USE_NUMBER
             /// @brief list of registered beverage settings
             std::vector<philips_beverage_setting::BeverageSetting *> beverage_settings_;
 #endif
-#endif
 
 #ifdef USE_BUTTON
             /// @brief list of registered action buttons
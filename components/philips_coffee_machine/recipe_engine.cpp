@@ -0,0 +1,193 @@
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "recipe_engine.h"
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        static const char *const TAG = "philips_recipe";
+
+        bool RecipeEngine::is_valid(const Recipe &recipe)
+        {
+            if (recipe.drink >= DRINK_COUNT || drink_command(recipe.drink) == nullptr)
+            {
+                ESP_LOGE(TAG, "Recipe rejected, drink %d is not available on this model", recipe.drink);
+                return false;
+            }
+
+            if (selected_state(recipe.drink, recipe.ground) == MachineState::UNKNOWN)
+            {
+                ESP_LOGE(TAG, "Recipe rejected, drink %d can not be made from ground coffee", recipe.drink);
+                return false;
+            }
+
+            // Steps are only confirmed by the decoded state, which is not known for every drink on every model
+            if (!is_selection_decodable(recipe.drink, recipe.ground))
+            {
+                ESP_LOGE(TAG, "Recipe rejected, the selection of drink %d is not recognized on this model", recipe.drink);
+                return false;
+            }
+
+            if (recipe.bean_level > RECIPE_LEVEL_COUNT || recipe.size_level > RECIPE_LEVEL_COUNT || recipe.milk_level > RECIPE_LEVEL_COUNT)
+            {
+                ESP_LOGE(TAG, "Recipe rejected, levels range from 1 to %d", RECIPE_LEVEL_COUNT);
+                return false;
+            }
+            return true;
+        }
+
+        bool RecipeEngine::start(const Recipe &recipe, const MachineSnapshot &snapshot)
+        {
+            if (is_active())
+            {
+                ESP_LOGW(TAG, "Recipe rejected, another recipe is being prepared");
+                return false;
+            }
+
+            if (!is_valid(recipe))
+                return false;
+
+            if (!snapshot.is_ready())
+            {
+                ESP_LOGW(TAG, "Recipe rejected, the machine is not ready");
+                return false;
+            }
+
+            recipe_ = recipe;
+#ifndef PHILIPS_EP3243
+            // The amount of milk can only be changed on the EP3243
+            recipe_.milk_level = 0;
+#endif
+
+            ESP_LOGD(TAG, "Preparing drink %d (bean: %d, size: %d, milk: %d, ground: %d)",
+                     recipe_.drink, recipe_.bean_level, recipe_.size_level, recipe_.milk_level, recipe_.ground);
+            step_ = RECIPE_STEP_SELECT;
+            attempts_ = 0;
+            recipe_start_ = millis();
+            return true;
+        }
+
+        void RecipeEngine::cancel()
+        {
+            if (!is_active())
+                return;
+
+            ESP_LOGD(TAG, "Recipe cancelled in step %d", step_);
+            step_ = RECIPE_STEP_IDLE;
+        }
+
+        void RecipeEngine::update(const MachineSnapshot &snapshot)
+        {
+            if (!is_active())
+                return;
+
+            if (snapshot.state == MachineState::OFF)
+            {
+                ESP_LOGW(TAG, "Machine turned off, recipe aborted");
+                step_ = RECIPE_STEP_IDLE;
+                return;
+            }
+
+            uint32_t now = millis();
+
+            // Once play/pause has been pressed the selection no longer matches, only wait for the drink to be brewed
+            if (step_ == RECIPE_STEP_BREW && attempts_ > 0)
+            {
+                if (snapshot.frame_state == brewing_state(recipe_.drink) || snapshot.frame_state == MachineState::PREPARING)
+                {
+                    ESP_LOGI(TAG, "Brewing drink %d after %u ms", recipe_.drink, now - recipe_start_);
+                    step_ = RECIPE_STEP_IDLE;
+                    return;
+                }
+                if (now - step_start_ < RECIPE_STEP_TIMEOUT || bus_->queue_depth() > 0)
+                    return;
+            }
+
+            RecipeStep step = pending_step(snapshot);
+            if (step != step_)
+            {
+                step_ = step;
+                attempts_ = 0;
+            }
+            else if (attempts_ > 0 && (now - step_start_ < RECIPE_STEP_TIMEOUT || bus_->queue_depth() > 0))
+            {
+                // Wait for the mainboard to confirm the previous presses, acknowledged presses may still be in flight
+                return;
+            }
+
+            if (attempts_ >= RECIPE_MAX_ATTEMPTS)
+            {
+                ESP_LOGW(TAG, "Step %d has not been confirmed after %d attempts, recipe aborted", step_, attempts_);
+                step_ = RECIPE_STEP_IDLE;
+                return;
+            }
+
+            press(step_, snapshot);
+            attempts_++;
+            step_start_ = now;
+        }
+
+        RecipeStep RecipeEngine::pending_step(const MachineSnapshot &snapshot) const
+        {
+            MachineState state = snapshot.frame_state;
+            MachineState selected = selected_state(recipe_.drink, recipe_.ground);
+            MachineState bean_selected = selected_state(recipe_.drink, false);
+            MachineState ground_selected = selected_state(recipe_.drink, true);
+
+            if (state != bean_selected && (ground_selected == MachineState::UNKNOWN || state != ground_selected))
+                return RECIPE_STEP_SELECT;
+            if (state != selected)
+                return RECIPE_STEP_GROUND;
+            if (!recipe_.ground && recipe_.bean_level != 0 && snapshot.bean_level != recipe_.bean_level)
+                return RECIPE_STEP_BEAN;
+            if (recipe_.size_level != 0 && snapshot.size_level != recipe_.size_level)
+                return RECIPE_STEP_SIZE;
+            if (recipe_.milk_level != 0 && snapshot.milk_level != recipe_.milk_level)
+                return RECIPE_STEP_MILK;
+            return RECIPE_STEP_BREW;
+        }
+
+        void RecipeEngine::press(RecipeStep step, const MachineSnapshot &snapshot)
+        {
+            switch (step)
+            {
+            case RECIPE_STEP_SELECT:
+                bus_->enqueue(*drink_command(recipe_.drink), TX_PRIORITY_ACTION, MESSAGE_REPETITIONS, 0, LEDS_DRINK);
+                break;
+            case RECIPE_STEP_GROUND:
+                // Ground coffee is part of the bean cycle, thus it is approached one press at a time
+                bus_->enqueue(command_press_bean, TX_PRIORITY_ACTION, MESSAGE_REPETITIONS, 0, LEDS_BEAN);
+                break;
+            case RECIPE_STEP_BEAN:
+                press_level(command_press_bean, LEDS_BEAN, snapshot.bean_level, recipe_.bean_level);
+                break;
+            case RECIPE_STEP_SIZE:
+                press_level(command_press_size, LEDS_SIZE, snapshot.size_level, recipe_.size_level);
+                break;
+#ifdef PHILIPS_EP3243
+            case RECIPE_STEP_MILK:
+                press_level(command_press_milk, LEDS_MILK, snapshot.milk_level, recipe_.milk_level);
+                break;
+#endif
+            case RECIPE_STEP_BREW:
+                bus_->enqueue(command_press_play_pause, TX_PRIORITY_ACTION, MESSAGE_REPETITIONS, 0, LEDS_BREW);
+                break;
+            default:
+                break;
+            }
+        }
+
+        void RecipeEngine::press_level(const Command &command, uint16_t ack_leds, uint8_t level, uint8_t target)
+        {
+            // A hidden or unknown level is advanced by a single press
+            uint8_t presses = 1;
+            if (level >= 1 && level <= RECIPE_LEVEL_COUNT)
+                presses = (target - level + RECIPE_LEVEL_COUNT) % RECIPE_LEVEL_COUNT;
+
+            for (uint8_t i = 0; i < presses; i++)
+                bus_->enqueue(command, TX_PRIORITY_ACTION, MESSAGE_REPETITIONS, i == 0 ? 0 : RECIPE_PRESS_GAP, ack_leds);
+        }
+
+    } // namespace philips_coffee_machine
+} // namespace esphome
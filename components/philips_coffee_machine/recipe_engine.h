@@ -0,0 +1,153 @@
+#pragma once
+
+#include <stdint.h>
+#include "bus_arbiter.h"
+#include "drinks.h"
+#include "machine_snapshot.h"
+
+#define MESSAGE_REPETITIONS 5
+// Pause between two presses of the same button, the mainboard has to see display messages in between
+#define RECIPE_PRESS_GAP 150
+// Time within which a step has to be confirmed by the mainboard messages before its presses are repeated
+#define RECIPE_STEP_TIMEOUT 1500
+#define RECIPE_MAX_ATTEMPTS 3
+// Bean, size and milk levels cycle through 1 -> 2 -> 3 -> 1
+#define RECIPE_LEVEL_COUNT 3
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        /**
+         * @brief Drink and settings which are prepared as a whole
+         */
+        struct Recipe
+        {
+            /// @brief drink to brew
+            Drink drink = DRINK_COFFEE;
+            /// @brief strength from 1 to 3, 0 keeps the current strength
+            uint8_t bean_level = 0;
+            /// @brief size from 1 to 3, 0 keeps the current size
+            uint8_t size_level = 0;
+            /// @brief amount of milk from 1 to 3, 0 keeps the current amount
+            uint8_t milk_level = 0;
+            /// @brief true if ground coffee is used instead of beans
+            bool ground = false;
+        };
+
+        /**
+         * @brief Steps of a recipe, executed in this order
+         */
+        enum RecipeStep : uint8_t
+        {
+            RECIPE_STEP_IDLE = 0,
+            RECIPE_STEP_SELECT,
+            RECIPE_STEP_GROUND,
+            RECIPE_STEP_BEAN,
+            RECIPE_STEP_SIZE,
+            RECIPE_STEP_MILK,
+            RECIPE_STEP_BREW,
+        };
+
+        /**
+         * @brief Prepares a drink with the given settings as a single non-blocking sequence.
+         * Every snapshot is compared to the recipe, the first step which does not match is executed next.
+         * Presses of a step are only repeated if the mainboard messages did not confirm them within RECIPE_STEP_TIMEOUT,
+         * play/pause is only pressed once drink and all settings match.
+         */
+        class RecipeEngine
+        {
+        public:
+            /**
+             * @brief Sets the arbiter of the mainboard bus used to send the button presses
+             *
+             * @param bus bus arbiter reference
+             */
+            void set_bus(BusArbiter *bus)
+            {
+                bus_ = bus;
+            }
+
+            /**
+             * @brief Determines if a recipe can be prepared on the configured model
+             *
+             * @param recipe drink and settings
+             */
+            static bool is_valid(const Recipe &recipe);
+
+            /**
+             * @brief Starts preparing a recipe
+             *
+             * @param recipe drink and settings
+             * @param snapshot most recent snapshot, the machine has to be idle or have a drink selected
+             * @return false if the recipe has been rejected
+             */
+            bool start(const Recipe &recipe, const MachineSnapshot &snapshot);
+
+            /**
+             * @brief Stops the current recipe without brewing
+             */
+            void cancel();
+
+            /**
+             * @brief Executes the next step of the current recipe if the snapshot allows it
+             *
+             * @param snapshot decoded mainboard message
+             */
+            void update(const MachineSnapshot &snapshot);
+
+            /**
+             * @brief Determines if a recipe is currently being prepared
+             */
+            bool is_active() const
+            {
+                return step_ != RECIPE_STEP_IDLE;
+            }
+
+        private:
+            /**
+             * @brief Determines the first step of the recipe which does not match the snapshot
+             *
+             * @param snapshot decoded mainboard message
+             */
+            RecipeStep pending_step(const MachineSnapshot &snapshot) const;
+
+            /**
+             * @brief Enqueues the presses of a step
+             *
+             * @param step step to execute
+             * @param snapshot decoded mainboard message
+             */
+            void press(RecipeStep step, const MachineSnapshot &snapshot);
+
+            /**
+             * @brief Enqueues all presses required to get from the current level to the target level
+             *
+             * @param command button which advances the level
+             * @param ack_leds leds which show the level
+             * @param level current level
+             * @param target target level
+             */
+            void press_level(const Command &command, uint16_t ack_leds, uint8_t level, uint8_t target);
+
+            /// @brief arbiter of the mainboard bus
+            BusArbiter *bus_ = nullptr;
+
+            /// @brief recipe which is currently prepared
+            Recipe recipe_;
+
+            /// @brief step which is currently executed
+            RecipeStep step_ = RECIPE_STEP_IDLE;
+
+            /// @brief nr of times the presses of the current step have been sent
+            uint8_t attempts_ = 0;
+
+            /// @brief time at which the presses of the current step have been sent
+            uint32_t step_start_ = 0;
+
+            /// @brief time at which the recipe has been started
+            uint32_t recipe_start_ = 0;
+        };
+
+    } // namespace philips_coffee_machine
+} // namespace esphome
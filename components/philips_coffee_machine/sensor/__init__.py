@@ -0,0 +1,57 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import CONF_TYPE, ENTITY_CATEGORY_DIAGNOSTIC, STATE_CLASS_MEASUREMENT
+
+from .. import CONTROLLER_ID, PhilipsCoffeeMachine, philips_coffee_machine_ns
+
+AUTO_LOAD = ["sensor"]
+DEPENDENCIES = ["philips_coffee_machine"]
+
+philips_diagnostic_sensor_ns = philips_coffee_machine_ns.namespace(
+    "philips_diagnostic_sensor"
+)
+DiagnosticSensor = philips_diagnostic_sensor_ns.class_(
+    "DiagnosticSensor", sensor.Sensor, cg.Component
+)
+
+Type = philips_diagnostic_sensor_ns.enum("Type")
+TYPES = {
+    "TX_QUEUE_DEPTH": Type.TX_QUEUE_DEPTH,
+    "TX_DROPPED": Type.TX_DROPPED,
+    "LOOP_TIME": Type.LOOP_TIME,
+    "LOOP_TIME_MAX": Type.LOOP_TIME_MAX,
+    "FLUSH_TIME": Type.FLUSH_TIME,
+    "BLINK_PERIOD": Type.BLINK_PERIOD,
+    "DISPLAY_BOOT_TIME": Type.DISPLAY_BOOT_TIME,
+    "POWER_TRIPS": Type.POWER_TRIPS,
+    "TIME_TO_IDLE": Type.TIME_TO_IDLE,
+    "POWER_ON_FAILURES": Type.POWER_ON_FAILURES,
+    "DRINK_QUEUE_LENGTH": Type.DRINK_QUEUE_LENGTH,
+    "DRINK_QUEUE_POSITION": Type.DRINK_QUEUE_POSITION,
+    "ACK_SUCCESS_RATE": Type.ACK_SUCCESS_RATE,
+    "ACK_FRAMES": Type.ACK_FRAMES,
+    "CACHED_REPLIES": Type.CACHED_REPLIES,
+    "MAINBOARD_FRAME_RATE": Type.MAINBOARD_FRAME_RATE,
+}
+
+CONFIG_SCHEMA = sensor.sensor_schema(
+    DiagnosticSensor,
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_MEASUREMENT,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+).extend(
+    {
+        cv.Required(CONTROLLER_ID): cv.use_id(PhilipsCoffeeMachine),
+        cv.Required(CONF_TYPE): cv.enum(TYPES, upper=True, space="_"),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONTROLLER_ID])
+    var = await sensor.new_sensor(config)
+    await cg.register_component(var, config)
+
+    cg.add(var.set_type(config[CONF_TYPE]))
+    cg.add(parent.add_diagnostic_sensor(var))
@@ -0,0 +1,20 @@
+#include "esphome/core/log.h"
+#include "diagnostic_sensor.h"
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        namespace philips_diagnostic_sensor
+        {
+            static const char *const TAG = "philips-diagnostic-sensor";
+
+            void DiagnosticSensor::dump_config()
+            {
+                LOG_SENSOR("", "Philips Diagnostic Sensor", this);
+                ESP_LOGCONFIG(TAG, "  Type: %d", type_);
+            }
+
+        } // namespace philips_diagnostic_sensor
+    }     // namespace philips_coffee_machine
+} // namespace esphome
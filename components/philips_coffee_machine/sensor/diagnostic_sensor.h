@@ -0,0 +1,79 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        namespace philips_diagnostic_sensor
+        {
+            /**
+             * @brief Values which can be reported by a diagnostic sensor
+             */
+            enum Type
+            {
+                TX_QUEUE_DEPTH = 0,
+                TX_DROPPED,
+                LOOP_TIME,
+                LOOP_TIME_MAX,
+                FLUSH_TIME,
+                BLINK_PERIOD,
+                DISPLAY_BOOT_TIME,
+                POWER_TRIPS,
+                TIME_TO_IDLE,
+                POWER_ON_FAILURES,
+                DRINK_QUEUE_LENGTH,
+                DRINK_QUEUE_POSITION,
+                ACK_SUCCESS_RATE,
+                ACK_FRAMES,
+                CACHED_REPLIES,
+                MAINBOARD_FRAME_RATE,
+            };
+
+            /**
+             * @brief Reports internal metrics of the controller. The values are published by the controller.
+             */
+            class DiagnosticSensor : public sensor::Sensor, public Component
+            {
+            public:
+                void dump_config() override;
+
+                /**
+                 * @brief Sets the value reported by this sensor
+                 *
+                 * @param type reported value
+                 */
+                void set_type(Type type)
+                {
+                    type_ = type;
+                }
+
+                /**
+                 * @brief The value reported by this sensor
+                 */
+                Type get_type() const
+                {
+                    return type_;
+                }
+
+                /**
+                 * @brief Publishes the value if it differs from the current state
+                 *
+                 * @param value new value
+                 */
+                void update_value(float value)
+                {
+                    if (!has_state() || state != value)
+                        publish_state(value);
+                }
+
+            private:
+                /// @brief reported value
+                Type type_ = TX_QUEUE_DEPTH;
+            };
+
+        } // namespace philips_diagnostic_sensor
+    }     // namespace philips_coffee_machine
+} // namespace esphome
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        /**
+         * @brief Lock-free single-producer/single-consumer ring.
+         * push() may only be called by one thread and pop() by one (possibly different) thread.
+         * Both indices grow monotonically and are only ever written by their owning side.
+         *
+         * @tparam T element type, copied in and out
+         * @tparam N capacity, must be a power of two
+         */
+        template <typename T, std::size_t N>
+        class SpscRing
+        {
+            static_assert(N > 0 && (N & (N - 1)) == 0, "Ring capacity must be a power of two");
+
+        public:
+            /**
+             * @brief Appends an element (producer side)
+             *
+             * @param item element to copy into the ring
+             * @return false if the ring is full
+             */
+            bool push(const T &item)
+            {
+                std::size_t head = head_.load(std::memory_order_relaxed);
+                if (head - tail_.load(std::memory_order_acquire) == N)
+                    return false;
+
+                items_[head & (N - 1)] = item;
+                head_.store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Removes the oldest element (consumer side)
+             *
+             * @param item receives the element
+             * @return false if the ring is empty
+             */
+            bool pop(T &item)
+            {
+                std::size_t tail = tail_.load(std::memory_order_relaxed);
+                if (head_.load(std::memory_order_acquire) == tail)
+                    return false;
+
+                item = items_[tail & (N - 1)];
+                tail_.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Number of stored elements. Only a snapshot if called concurrently.
+             */
+            std::size_t size() const
+            {
+                return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+            }
+
+        private:
+            /// @brief stored elements
+            T items_[N];
+
+            /// @brief index of the next element to write, owned by the producer
+            std::atomic<std::size_t> head_{0};
+
+            /// @brief index of the next element to read, owned by the consumer
+            std::atomic<std::size_t> tail_{0};
+        };
+
+    } // namespace philips_coffee_machine
+} // namespace esphome
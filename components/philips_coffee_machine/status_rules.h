@@ -0,0 +1,320 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdint.h>
+#include "commands.h"
+#include "machine_snapshot.h"
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        /// @brief number of LED bytes packed into the first word
+        static constexpr std::size_t LED_LOW_COUNT = 8;
+
+        /**
+         * @brief The LED bytes of a mainboard frame packed into two words, byte n is stored at bit 8 * (n - 2) of low
+         * for n < 10 and at bit 8 * (n - 10) of high otherwise.
+         */
+        struct LedWords
+        {
+            uint64_t low;
+            uint64_t high;
+        };
+
+        /**
+         * @brief Set of LED conditions which can be compared with a frame using word-wide masks
+         */
+        struct LedPattern
+        {
+            uint64_t mask_low;
+            uint64_t mask_high;
+            uint64_t value_low;
+            uint64_t value_high;
+        };
+
+        /**
+         * @brief Qualifiers which are derived from the LED history instead of a single frame
+         */
+        enum StatusQualifier : uint8_t
+        {
+            QUALIFIER_NONE = 0,
+            /// @brief the play/pause led has changed recently
+            QUALIFIER_BLINKING = 1 << 0,
+            /// @brief the play/pause led has not changed recently
+            QUALIFIER_STEADY = 1 << 1,
+            /// @brief the size led has changed recently (programming mode)
+            QUALIFIER_SIZE_CHANGED = 1 << 2,
+        };
+
+        /**
+         * @brief Maps a LED pattern and qualifiers to a state
+         */
+        struct StatusRule
+        {
+            /// @brief conditions which have to match
+            LedPattern pattern;
+            /// @brief conditions which must not match as a whole, ignored if the mask is empty
+            LedPattern exclude;
+            /// @brief qualifiers which have to be present
+            uint8_t qualifiers;
+            /// @brief state reported if the rule matches
+            MachineState state;
+        };
+
+        /**
+         * @brief Packs the LED bytes of a mainboard frame into words
+         *
+         * @param data mainboard frame (19 bytes)
+         */
+        constexpr LedWords load_led_words(const uint8_t *data)
+        {
+            LedWords words = {0, 0};
+            for (std::size_t i = 0; i < LED_LOW_COUNT; i++)
+                words.low |= (uint64_t)data[LED_OFFSET + i] << (8 * i);
+            for (std::size_t i = LED_LOW_COUNT; i < LED_COUNT; i++)
+                words.high |= (uint64_t)data[LED_OFFSET + i] << (8 * (i - LED_LOW_COUNT));
+            return words;
+        }
+
+        /**
+         * @brief Condition for a single LED byte
+         *
+         * @param index byte index within the mainboard frame (2 to 16)
+         * @param value required led value
+         */
+        constexpr LedPattern led(std::size_t index, uint8_t value)
+        {
+            std::size_t i = index - LED_OFFSET;
+            return i < LED_LOW_COUNT
+                       ? LedPattern{(uint64_t)0xFF << (8 * i), 0, (uint64_t)value << (8 * i), 0}
+                       : LedPattern{0, (uint64_t)0xFF << (8 * (i - LED_LOW_COUNT)), 0, (uint64_t)value << (8 * (i - LED_LOW_COUNT))};
+        }
+
+        /**
+         * @brief Combines two patterns, both have to match
+         */
+        constexpr LedPattern operator&(const LedPattern &a, const LedPattern &b)
+        {
+            return {a.mask_low | b.mask_low, a.mask_high | b.mask_high, a.value_low | b.value_low, a.value_high | b.value_high};
+        }
+
+        /// @brief pattern without conditions
+        static constexpr LedPattern LED_ANY = {0, 0, 0, 0};
+
+        /**
+         * @brief Determines if all conditions of a pattern match
+         */
+        constexpr bool matches(const LedPattern &pattern, const LedWords &leds)
+        {
+            return ((leds.low & pattern.mask_low) == pattern.value_low) && ((leds.high & pattern.mask_high) == pattern.value_high);
+        }
+
+        /**
+         * @brief Determines if a rule matches
+         *
+         * @param rule rule to check
+         * @param leds packed LED bytes
+         * @param qualifiers currently present qualifiers
+         */
+        constexpr bool matches(const StatusRule &rule, const LedWords &leds, uint8_t qualifiers)
+        {
+            return (rule.qualifiers & ~qualifiers) == 0 && matches(rule.pattern, leds) &&
+                   ((rule.exclude.mask_low | rule.exclude.mask_high) == 0 || !matches(rule.exclude, leds));
+        }
+
+        /**
+         * @brief Builds a rule
+         *
+         * @param pattern conditions which have to match
+         * @param qualifiers qualifiers which have to be present
+         * @param state state reported if the rule matches
+         * @param exclude conditions which must not match as a whole
+         */
+        constexpr StatusRule rule(const LedPattern &pattern, uint8_t qualifiers, MachineState state, const LedPattern &exclude = LED_ANY)
+        {
+            return {pattern, exclude, qualifiers, state};
+        }
+
+        static constexpr uint8_t BLINKING = QUALIFIER_BLINKING;
+        static constexpr uint8_t STEADY = QUALIFIER_STEADY;
+        static constexpr uint8_t PROGRAMMING = QUALIFIER_BLINKING | QUALIFIER_SIZE_CHANGED;
+
+        /// @brief the ground coffee led
+        static constexpr LedPattern GROUND = led(9, led_second);
+
+        /// @brief the size led is off, blinks in programming mode
+        static constexpr LedPattern SIZE_OFF = led(11, led_off);
+
+        /**
+         * @brief Rules of all states, the first matching rule determines the state.
+         * Within a beverage the qualifiers decide between ground coffee, programming mode, selected and brewing.
+         * Inline, so that the table exists once per image although several translation units include this header.
+         */
+        inline constexpr StatusRule status_rules[] = {
+        // Idle state (selection leds on)
+#ifdef PHILIPS_EP3243
+            rule(led(3, led_on) & led(4, led_on) & led(5, led_on) & led(13, led_off) & led(14, led_off) & led(15, led_off), QUALIFIER_NONE, MachineState::IDLE),
+#else
+            rule(led(3, led_on) & led(4, led_on) & led(5, led_on), QUALIFIER_NONE, MachineState::IDLE, led(6, led_off)),
+#endif
+
+            // Rotating icons, cleaning if the play/pause led is on
+            rule(led(3, led_half) & led(16, led_on), QUALIFIER_NONE, MachineState::CLEANING),
+            rule(led(3, led_half), QUALIFIER_NONE, MachineState::PREPARING),
+            rule(led(4, led_half) & led(16, led_on), QUALIFIER_NONE, MachineState::CLEANING),
+            rule(led(4, led_half), QUALIFIER_NONE, MachineState::PREPARING),
+            rule(led(5, led_half) & led(16, led_on), QUALIFIER_NONE, MachineState::CLEANING),
+            rule(led(5, led_half), QUALIFIER_NONE, MachineState::PREPARING),
+            rule(led(6, led_half) & led(16, led_on), QUALIFIER_NONE, MachineState::CLEANING),
+            rule(led(6, led_half), QUALIFIER_NONE, MachineState::PREPARING),
+
+            // 3 warning lights indicate an internal error (i.e. overheating)
+            rule(led(14, led_second), QUALIFIER_NONE, MachineState::INTERNAL_ERROR, led(15, led_off)),
+            // Warning/Error led
+            rule(led(15, led_second), QUALIFIER_NONE, MachineState::ERROR),
+            // Water empty led
+            rule(led(14, led_second), QUALIFIER_NONE, MachineState::WATER_EMPTY),
+            // Waste container led
+            rule(led(15, led_on), QUALIFIER_NONE, MachineState::WASTE_WARNING),
+
+            // Coffee selected
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_on) & led(6, led_off) & GROUND, BLINKING, MachineState::GROUND_COFFEE_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_on) & led(6, led_off) & SIZE_OFF, PROGRAMMING, MachineState::COFFEE_PROGRAMMING_MODE),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_on) & led(6, led_off), BLINKING, MachineState::COFFEE_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_on) & led(6, led_off), STEADY, MachineState::COFFEE_BREWING),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_second) & led(6, led_off) & GROUND, BLINKING, MachineState::GROUND_COFFEE_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_second) & led(6, led_off) & SIZE_OFF, PROGRAMMING, MachineState::COFFEE_PROGRAMMING_MODE),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_second) & led(6, led_off), BLINKING, MachineState::COFFEE_2X_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_second) & led(6, led_off), STEADY, MachineState::COFFEE_2X_BREWING),
+
+        // Steam selected
+#ifdef PHILIPS_EP2235
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_on) & GROUND, BLINKING, MachineState::GROUND_CAPPUCCINO_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_on) & SIZE_OFF, PROGRAMMING, MachineState::CAPPUCCINO_PROGRAMMING_MODE),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_on), BLINKING, MachineState::CAPPUCCINO_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_on), STEADY, MachineState::CAPPUCCINO_BREWING),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_third) & GROUND, BLINKING, MachineState::GROUND_CAPPUCCINO_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_third) & SIZE_OFF, PROGRAMMING, MachineState::CAPPUCCINO_PROGRAMMING_MODE),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_third), BLINKING, MachineState::CAPPUCCINO_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_third), STEADY, MachineState::CAPPUCCINO_BREWING),
+#elif defined(PHILIPS_EP3243)
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_on) & SIZE_OFF, PROGRAMMING, MachineState::LATTE_PROGRAMMING_MODE),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_on) & GROUND, BLINKING, MachineState::GROUND_LATTE_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_on), BLINKING, MachineState::LATTE_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_on), STEADY, MachineState::LATTE_BREWING),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_third) & SIZE_OFF, PROGRAMMING, MachineState::LATTE_PROGRAMMING_MODE),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_third) & GROUND, BLINKING, MachineState::GROUND_LATTE_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_third), BLINKING, MachineState::LATTE_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_third), STEADY, MachineState::LATTE_BREWING),
+#else
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_on), BLINKING, MachineState::STEAM_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_on), STEADY, MachineState::STEAM_BREWING),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_third), BLINKING, MachineState::STEAM_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_third), STEADY, MachineState::STEAM_BREWING),
+#endif
+
+        // Hot water selected
+#ifdef PHILIPS_EP3243
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_off) & led(7, led_second) & SIZE_OFF, PROGRAMMING, MachineState::HOT_WATER_PROGRAMMING_MODE),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_off) & led(7, led_second), BLINKING, MachineState::HOT_WATER_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_off) & led(7, led_second), STEADY, MachineState::HOT_WATER_BREWING),
+#else
+            rule(led(3, led_off) & led(4, led_on) & led(5, led_off) & led(6, led_off) & SIZE_OFF, PROGRAMMING, MachineState::HOT_WATER_PROGRAMMING_MODE),
+            rule(led(3, led_off) & led(4, led_on) & led(5, led_off) & led(6, led_off), BLINKING, MachineState::HOT_WATER_SELECTED),
+            rule(led(3, led_off) & led(4, led_on) & led(5, led_off) & led(6, led_off), STEADY, MachineState::HOT_WATER_BREWING),
+#endif
+
+            // Espresso selected
+            rule(led(3, led_on) & led(4, led_off) & led(5, led_off) & led(6, led_off) & GROUND, BLINKING, MachineState::GROUND_ESPRESSO_SELECTED),
+            rule(led(3, led_on) & led(4, led_off) & led(5, led_off) & led(6, led_off) & SIZE_OFF, PROGRAMMING, MachineState::ESPRESSO_PROGRAMMING_MODE),
+            rule(led(3, led_on) & led(4, led_off) & led(5, led_off) & led(6, led_off), BLINKING, MachineState::ESPRESSO_SELECTED),
+            rule(led(3, led_on) & led(4, led_off) & led(5, led_off) & led(6, led_off), STEADY, MachineState::ESPRESSO_BREWING),
+            rule(led(3, led_second) & led(4, led_off) & led(5, led_off) & led(6, led_off) & GROUND, BLINKING, MachineState::GROUND_ESPRESSO_SELECTED),
+            rule(led(3, led_second) & led(4, led_off) & led(5, led_off) & led(6, led_off) & SIZE_OFF, PROGRAMMING, MachineState::ESPRESSO_PROGRAMMING_MODE),
+            rule(led(3, led_second) & led(4, led_off) & led(5, led_off) & led(6, led_off), BLINKING, MachineState::ESPRESSO_2X_SELECTED),
+            rule(led(3, led_second) & led(4, led_off) & led(5, led_off) & led(6, led_off), STEADY, MachineState::ESPRESSO_2X_BREWING),
+
+#ifdef PHILIPS_EP3243
+            // Cappuccino selected
+            rule(led(3, led_off) & led(4, led_on) & led(5, led_off) & led(6, led_off) & SIZE_OFF, PROGRAMMING, MachineState::CAPPUCCINO_PROGRAMMING_MODE),
+            rule(led(3, led_off) & led(4, led_on) & led(5, led_off) & led(6, led_off) & GROUND, BLINKING, MachineState::GROUND_CAPPUCCINO_SELECTED),
+            rule(led(3, led_off) & led(4, led_on) & led(5, led_off) & led(6, led_off), BLINKING, MachineState::CAPPUCCINO_SELECTED),
+            rule(led(3, led_off) & led(4, led_on) & led(5, led_off) & led(6, led_off), STEADY, MachineState::CAPPUCCINO_BREWING),
+
+            // Americano selected, the 2x variant is only reported if the single led does not match
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_second) & GROUND, BLINKING, MachineState::GROUND_AMERICANO_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_second) & SIZE_OFF, PROGRAMMING, MachineState::AMERICANO_PROGRAMMING_MODE),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_second), BLINKING, MachineState::AMERICANO_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(6, led_second), STEADY, MachineState::AMERICANO_BREWING),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(7, led_on) & GROUND, BLINKING, MachineState::GROUND_AMERICANO_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(7, led_on) & SIZE_OFF, PROGRAMMING, MachineState::AMERICANO_PROGRAMMING_MODE),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(7, led_on), BLINKING, MachineState::AMERICANO_2X_SELECTED),
+            rule(led(3, led_off) & led(4, led_off) & led(5, led_off) & led(7, led_on), STEADY, MachineState::AMERICANO_2X_BREWING),
+#endif
+        };
+
+        /// @brief number of status rules of the configured model
+        static constexpr std::size_t STATUS_RULE_COUNT = sizeof(status_rules) / sizeof(status_rules[0]);
+
+        /**
+         * @brief Finds the first rule matching a frame
+         *
+         * @param leds packed LED bytes
+         * @param qualifiers currently present qualifiers
+         * @return matching rule or nullptr if the state is unknown
+         */
+        constexpr const StatusRule *find_status_rule(const LedWords &leds, uint8_t qualifiers)
+        {
+            for (std::size_t i = 0; i < STATUS_RULE_COUNT; i++)
+                if (matches(status_rules[i], leds, qualifiers))
+                    return &status_rules[i];
+            return nullptr;
+        }
+
+        /**
+         * @brief Determines if any rule of the configured model reports a state
+         *
+         * @param state state to look for
+         */
+        constexpr bool has_status_rule(MachineState state)
+        {
+            for (std::size_t i = 0; i < STATUS_RULE_COUNT; i++)
+                if (status_rules[i].state == state)
+                    return true;
+            return false;
+        }
+
+        /**
+         * @brief Decodes a LED state, used to verify the table at compile time
+         *
+         * @param leds LED bytes 2 to 16 of a mainboard frame
+         * @param qualifiers currently present qualifiers
+         * @return decoded state
+         */
+        constexpr MachineState decode_leds(const std::array<uint8_t, LED_COUNT> &leds, uint8_t qualifiers)
+        {
+            const uint8_t frame[MAINBOARD_FRAME_SIZE] = {message_header[0], message_header[1],
+                                                         leds[0], leds[1], leds[2], leds[3], leds[4], leds[5], leds[6], leds[7],
+                                                         leds[8], leds[9], leds[10], leds[11], leds[12], leds[13], leds[14], 0x00, 0x00};
+            const StatusRule *match = find_status_rule(load_led_words(frame), qualifiers);
+            return match == nullptr ? MachineState::UNKNOWN : match->state;
+        }
+
+        // The table must reproduce the decisions of the original comparison chain
+        //                                  2         3         4         5         6         7         8         9         10        11        12        13        14        15         16
+        static_assert(decode_leds({led_off, led_on,   led_on,   led_on,   led_on,   led_off,  led_off,  led_off,  led_off,  led_on,   led_off,  led_off,  led_off,  led_off,   led_off}, STEADY) == MachineState::IDLE, "idle");
+        static_assert(decode_leds({led_off, led_half, led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_on,   led_off,  led_off,  led_off,  led_off,   led_on}, STEADY) == MachineState::CLEANING, "cleaning");
+        static_assert(decode_leds({led_off, led_off,  led_half, led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_on,   led_off,  led_off,  led_off,  led_off,   led_off}, STEADY) == MachineState::PREPARING, "preparing");
+        static_assert(decode_leds({led_off, led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_on,   led_off,  led_off,  led_second, led_on,  led_off}, STEADY) == MachineState::INTERNAL_ERROR, "internal error");
+        static_assert(decode_leds({led_off, led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_on,   led_off,  led_off,  led_second, led_off, led_off}, STEADY) == MachineState::WATER_EMPTY, "water empty");
+        static_assert(decode_leds({led_off, led_off,  led_off,  led_on,   led_off,  led_off,  led_off,  led_off,  led_off,  led_on,   led_off,  led_off,  led_off,  led_off,   led_on}, BLINKING) == MachineState::COFFEE_SELECTED, "coffee selected");
+        static_assert(decode_leds({led_off, led_off,  led_off,  led_on,   led_off,  led_off,  led_off,  led_second, led_off, led_on,  led_off,  led_off,  led_off,  led_off,   led_on}, BLINKING) == MachineState::GROUND_COFFEE_SELECTED, "ground coffee selected");
+        static_assert(decode_leds({led_off, led_off,  led_off,  led_second, led_off, led_off,  led_off,  led_off,  led_off,  led_on,   led_off,  led_off,  led_off,  led_off,   led_on}, STEADY) == MachineState::COFFEE_2X_BREWING, "2x coffee brewing");
+        static_assert(decode_leds({led_off, led_on,   led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,   led_on}, PROGRAMMING) == MachineState::ESPRESSO_PROGRAMMING_MODE, "espresso programming mode");
+        static_assert(decode_leds({led_off, led_on,   led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,   led_on}, BLINKING) == MachineState::ESPRESSO_SELECTED, "espresso selected");
+        static_assert(decode_leds({led_off, led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,  led_off,   led_off}, STEADY) == MachineState::UNKNOWN, "unknown");
+
+    }     // namespace philips_coffee_machine
+} // namespace esphome
@@ -17,6 +17,18 @@ namespace esphome
 
             void Power::loop()
             {
+                // The power-on attempt is complete once the machine is ready
+                if (power_on_attempt_active_ && snapshot_ != nullptr && snapshot_->state == MachineState::IDLE)
+                {
+                    PowerOnAttempt &attempt = current_power_on_attempt();
+                    attempt.idle_time = millis() - attempt.start;
+                    finish_power_on_attempt();
+                }
+
+                // Off states are only notified once, apply an Off state which has been ignored during the grace period
+                if (this->state != reported_state_ && power_on_grace_period_end_ > 0 && millis() >= power_on_grace_period_end_)
+                    update_state(reported_state_);
+
                 if (should_power_trip_)
                 {
                     uint32_t now = millis();
@@ -28,6 +40,11 @@ namespace esphome
                         {
                             should_power_trip_ = false;
                             ESP_LOGE(TAG, "Power tripping display failed!");
+                            if (power_on_attempt_active_)
+                            {
+                                current_power_on_attempt().failed = true;
+                                finish_power_on_attempt();
+                            }
                             return;
                         }
 
@@ -61,14 +78,17 @@ namespace esphome
                         power_trip_active_ = false;
                         last_power_trip_ = now;
                         power_trip_count_++;
+                        if (power_on_attempt_active_)
+                            current_power_on_attempt().trips = power_trip_count_;
                         
                         // If this was the first power trip and we have pending commands, schedule them
                         if (power_trip_count_ == 1 && pending_power_on_commands_)
                         {
-                            // Schedule command sending after display boot delay
-                            // Display takes approximately 8-9 seconds to boot and start communicating
-                            send_commands_at_ = millis() + display_boot_delay_;
-                            ESP_LOGD(TAG, "Scheduled power-on commands to be sent in %d ms (at millis=%u)", 
+                            // Commands are sent as soon as the display sends its first message, the boot delay is only an upper bound
+                            power_restored_at_ = millis();
+                            display_frame_at_restore_ = bus_->last_display_frame_time();
+                            send_commands_at_ = power_restored_at_ + display_boot_delay_;
+                            ESP_LOGD(TAG, "Waiting for the display to boot, sending power-on commands in %d ms at the latest (at millis=%u)", 
                                      display_boot_delay_, send_commands_at_);
                             
                             // Set grace period to start NOW (when power is restored)
@@ -81,62 +101,96 @@ namespace esphome
                     }
                 }
                 
-                // Check if it's time to send pending power-on commands
-                if (pending_power_on_commands_ && send_commands_at_ > 0 && millis() >= send_commands_at_)
+                // Check if the display has booted or the boot delay has passed
+                if (pending_power_on_commands_ && !power_on_sequence_active_ && send_commands_at_ > 0)
                 {
-                    ESP_LOGW(TAG, "⚠️ Sending power-on commands after display boot delay (pending: %d, scheduled: %u, now: %u)", 
-                             pending_power_on_commands_, send_commands_at_, millis());
-                    
-                    // Start blocking ALL display messages during automated power-on sequence
-                    // This is OK because user initiated via phone/GUI, not physical button
-                    injecting_commands_ = true;
-                    
-                    // Send commands multiple times with delays to catch the display as it boots
-                    for (int attempt = 0; attempt < 3; attempt++)
+                    uint32_t display_frame_time = bus_->last_display_frame_time();
+                    bool display_booted = display_frame_time != display_frame_at_restore_;
+                    if (display_booted || millis() >= send_commands_at_)
                     {
-                        ESP_LOGD(TAG, "Command attempt %d - sending %d pre-power + power messages", 
-                                 attempt + 1, power_message_repetitions_ + 1);
-                        
-                        // Send pre-power on message
-                        for (unsigned int i = 0; i <= power_message_repetitions_; i++)
-                            mainboard_uart_->write_array(command_pre_power_on);
-
-                        // Send power on message
-                        if (cleaning_pending_)
+                        if (display_booted)
                         {
-                            // Send power WITH cleaning (starts flush cycle)
-                            ESP_LOGD(TAG, "Sending power-on WITH cleaning command");
-                            for (unsigned int i = 0; i <= power_message_repetitions_; i++)
-                                mainboard_uart_->write_array(command_power_with_cleaning);
+                            uint32_t boot_time = display_frame_time - power_restored_at_;
+                            ESP_LOGD(TAG, "Display booted after %u ms - sending power-on commands", boot_time);
+                            if (power_on_attempt_active_)
+                                current_power_on_attempt().boot_time = boot_time;
+
+                            // The display is awake, no further power trips are required
+                            should_power_trip_ = false;
                         }
                         else
                         {
-                            // Send power on command without cleaning
-                            ESP_LOGD(TAG, "Sending power-on WITHOUT cleaning command");
-                            for (unsigned int i = 0; i <= power_message_repetitions_; i++)
-                                mainboard_uart_->write_array(command_power_without_cleaning);
+                            ESP_LOGW(TAG, "No message from the display within %u ms - sending power-on commands anyway", display_boot_delay_);
                         }
 
-                        mainboard_uart_->flush();
+                        // Start blocking ALL display messages during automated power-on sequence
+                        // This is OK because user initiated via phone/GUI, not physical button
+                        bus_->acquire();
+                        power_on_sequence_active_ = true;
+                        power_on_attempt_ = 0;
+                        power_on_step_start_ = millis();
+                        power_on_step_delay_ = 0;
+                    }
+                }
+
+                // The delay of a step only starts once the previous burst has left the queue, thus bursts never overlap
+                // and the bus is only released after the last power-on message has been sent
+                if (power_on_sequence_active_ && bus_->queue_depth() != 0)
+                    power_on_step_start_ = millis();
+
+                // Send commands multiple times with delays to catch the display as it boots
+                // Each step is scheduled from loop() so the bridge keeps forwarding messages in between
+                if (power_on_sequence_active_ && millis() - power_on_step_start_ >= power_on_step_delay_)
+                {
+                    if (power_on_attempt_ < POWER_ON_ATTEMPTS)
+                    {
+                        ESP_LOGD(TAG, "Command attempt %d - sending %d pre-power + power messages", 
+                                 power_on_attempt_ + 1, power_message_repetitions_ + 1);
+                        send_power_on_commands(cleaning_pending_);
+
+                        power_on_attempt_++;
+                        power_on_step_start_ = millis();
+                        // Wait between attempts, keep blocking for a bit longer after the last attempt to ensure commands reach mainboard
+                        power_on_step_delay_ = power_on_attempt_ < POWER_ON_ATTEMPTS ? POWER_ON_ATTEMPT_DELAY : POWER_ON_HOLD_DURATION;
+                    }
+                    else
+                    {
+                        // Stop blocking - physical button can work again
+                        bus_->release();
+                        power_on_sequence_active_ = false;
+                        
+                        pending_power_on_commands_ = false;
+                        send_commands_at_ = 0;  // Clear scheduled time
                         
-                        if (attempt < 2)
-                            delay(300);  // Wait between attempts
+                        ESP_LOGD(TAG, "Power-on commands sent (%d attempts)", POWER_ON_ATTEMPTS);
+                        
+                        // Stop power tripping - we've done our job
+                        should_power_trip_ = false;
+                        ESP_LOGD(TAG, "Power trip sequence complete");
                     }
-                    
-                    // Keep blocking for a bit longer to ensure commands reach mainboard
-                    delay(500);
-                    
-                    // Stop blocking - physical button can work again
-                    injecting_commands_ = false;
-                    
-                    pending_power_on_commands_ = false;
-                    send_commands_at_ = 0;  // Clear scheduled time
-                    
-                    ESP_LOGD(TAG, "Power-on commands sent (3 attempts)");
-                    
-                    // Stop power tripping - we've done our job
-                    should_power_trip_ = false;
-                    ESP_LOGD(TAG, "Power trip sequence complete");
+                }
+            }
+
+            void Power::send_power_on_commands(bool cleaning)
+            {
+                // Bursts are sent without waiting for acknowledgements, like the display does while booting.
+                // Waiting up to ACK_TIMEOUT per frame would stretch a burst to seconds while the bus is held.
+
+                // Send pre-power on message
+                bus_->enqueue(command_pre_power_on, TX_PRIORITY_POWER, power_message_repetitions_);
+
+                // Send power on message
+                if (cleaning)
+                {
+                    // Send power WITH cleaning (starts flush cycle)
+                    ESP_LOGD(TAG, "Sending power-on WITH cleaning command");
+                    bus_->enqueue(command_power_with_cleaning, TX_PRIORITY_POWER, power_message_repetitions_);
+                }
+                else
+                {
+                    // Send power on command without cleaning
+                    ESP_LOGD(TAG, "Sending power-on WITHOUT cleaning command");
+                    bus_->enqueue(command_power_without_cleaning, TX_PRIORITY_POWER, power_message_repetitions_);
                 }
             }
 
@@ -149,34 +203,20 @@ namespace esphome
                     {
                         ESP_LOGD(TAG, "Power ON requested but display already communicating - just sending commands");
                         
-                        // Block display messages ONLY while injecting our commands
-                        injecting_commands_ = true;
-                        
-                        // Send pre-power on message
-                        for (unsigned int i = 0; i <= power_message_repetitions_; i++)
-                            mainboard_uart_->write_array(command_pre_power_on);
-
-                        // Send power on message
-                        if (cleaning_)
-                        {
-                            ESP_LOGD(TAG, "Sending power-on WITH cleaning");
-                            for (unsigned int i = 0; i <= power_message_repetitions_; i++)
-                                mainboard_uart_->write_array(command_power_with_cleaning);
-                        }
-                        else
-                        {
-                            ESP_LOGD(TAG, "Sending power-on WITHOUT cleaning");
-                            for (unsigned int i = 0; i <= power_message_repetitions_; i++)
-                                mainboard_uart_->write_array(command_power_without_cleaning);
-                        }
-                        mainboard_uart_->flush();
-                        
-                        // Stop blocking immediately - allow physical button to work
-                        injecting_commands_ = false;
+                        // The bus arbiter places our commands between display messages
+                        send_power_on_commands(cleaning_);
                         
                         ESP_LOGD(TAG, "Power-on commands sent (no power trip needed)");
                         return;
                     }
+
+                    // The controller polls the mainboard itself, there is no display which has to be woken up first
+                    if (bus_->is_emulating_display())
+                    {
+                        ESP_LOGD(TAG, "Power ON requested while emulating the display - sending commands without power trip");
+                        send_power_on_commands(cleaning_);
+                        return;
+                    }
                     
                     ESP_LOGD(TAG, "Power ON requested - display not communicating, will power trip first");
                     
@@ -186,6 +226,8 @@ namespace esphome
                     power_trip_count_ = 0;
                     last_power_trip_ = 0; // Trigger immediately
                     
+                    begin_power_on_attempt();
+
                     // Mark that we need to send power-on commands after power trip
                     pending_power_on_commands_ = true;
                     cleaning_pending_ = cleaning_;
@@ -197,26 +239,47 @@ namespace esphome
                 }
                 else
                 {
-                    // Block display messages ONLY while injecting power-off command
-                    injecting_commands_ = true;
-                    
                     // Send power off message multiple times to ensure it's received
-                    ESP_LOGD(TAG, "Sending power-off command (%d repetitions)", power_message_repetitions_ + 1);
-                    for (unsigned int i = 0; i <= power_message_repetitions_; i++)
-                        mainboard_uart_->write_array(command_power_off);
-                    mainboard_uart_->flush();
-                    
-                    // Stop blocking immediately
-                    injecting_commands_ = false;
-                    
-                    // Wait for machine to process power-off (without blocking physical button)
-                    ESP_LOGD(TAG, "Waiting 2s for machine to process power-off command");
-                    delay(2000);
+                    ESP_LOGD(TAG, "Sending power-off command (up to %d repetitions)", power_message_repetitions_ + 1);
+                    bus_->enqueue(command_power_off, TX_PRIORITY_POWER, power_message_repetitions_, 0, LEDS_ALL);
                 }
 
                 // The state will be published once the display starts sending messages
             }
 
+            void Power::begin_power_on_attempt()
+            {
+                if (history_count_ == POWER_ON_HISTORY_SIZE)
+                    history_head_ = (history_head_ + 1) % POWER_ON_HISTORY_SIZE;
+                else
+                    history_count_++;
+
+                PowerOnAttempt &attempt = current_power_on_attempt();
+                attempt = PowerOnAttempt();
+                attempt.start = millis();
+                power_on_attempt_active_ = true;
+            }
+
+            void Power::finish_power_on_attempt()
+            {
+                const PowerOnAttempt &attempt = current_power_on_attempt();
+                ESP_LOGI(TAG, "Power-on attempt %s - %d power trip(s), display boot: %u ms, idle after: %u ms",
+                         attempt.failed ? "failed" : (attempt.idle_time > 0 ? "succeeded" : "aborted"),
+                         attempt.trips, attempt.boot_time, attempt.idle_time);
+                power_on_attempt_active_ = false;
+            }
+
+            uint8_t Power::failed_power_on_attempts() const
+            {
+                uint8_t failed = 0;
+                for (uint8_t i = 0; i < history_count_; i++)
+                {
+                    if (history_[(history_head_ + i) % POWER_ON_HISTORY_SIZE].failed)
+                        failed++;
+                }
+                return failed;
+            }
+
             void Power::dump_config()
             {
                 ESP_LOGCONFIG(TAG, "Philips Coffee Machine Power Switch");
@@ -225,6 +288,7 @@ namespace esphome
             void Power::update_state(bool state)
             {
                 uint32_t now = millis();
+                reported_state_ = state;
                 
                 // During grace period after power-on, ignore OFF state
                 // Give the display time to boot and start communicating
@@ -253,12 +317,12 @@ namespace esphome
                     if (state && power_on_grace_period_end_ > 0)
                     {
                         bool has_valid_status = false;
-                        if (status_sensor_ != nullptr && status_sensor_->has_state())
+                        if (snapshot_ != nullptr)
                         {
-                            std::string status = status_sensor_->state;
+                            MachineState status = snapshot_->state;
                             // Check if status indicates machine is actually ON (not Off, not Unknown)
                             // Valid ON states: Idle, Preparing, Cleaning, Coffee Selected, etc.
-                            has_valid_status = (status != state_off && status != state_unknown && !status.empty());
+                            has_valid_status = (status != MachineState::OFF && status != MachineState::UNKNOWN);
                         }
                         
                         if (has_valid_status)
@@ -278,6 +342,13 @@ namespace esphome
                         power_trip_active_ = false;
                         pending_power_on_commands_ = false;
                         send_commands_at_ = 0;  // Clear any scheduled commands
+                        if (power_on_sequence_active_)
+                        {
+                            power_on_sequence_active_ = false;
+                            bus_->release();
+                        }
+                        if (power_on_attempt_active_)
+                            finish_power_on_attempt();
                     }
                 }
             }
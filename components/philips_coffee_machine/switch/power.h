@@ -2,15 +2,19 @@
 
 #include "esphome/core/component.h"
 #include "esphome/components/switch/switch.h"
-#include "esphome/components/uart/uart.h"
+#include "../bus_arbiter.h"
 #include "../commands.h"
-#include "../text_sensor/status_sensor.h"
+#include "../machine_snapshot.h"
 
 #define MESSAGE_REPETITIONS 5
 #define POWER_TRIP_RETRY_DELAY 100
 #define MAX_POWER_TRIP_COUNT 5
 #define POWER_ON_GRACE_PERIOD 10000  // 10 seconds for display to boot after power trip
 #define DISPLAY_POWER_CUT_DURATION 2000  // 2 seconds power cut to ensure full shutdown
+#define POWER_ON_ATTEMPTS 3
+#define POWER_ON_ATTEMPT_DELAY 300
+#define POWER_ON_HOLD_DURATION 500
+#define POWER_ON_HISTORY_SIZE 8
 
 namespace esphome
 {
@@ -19,6 +23,23 @@ namespace esphome
         namespace philips_power_switch
         {
 
+            /**
+             * @brief Outcome of a power-on request which required power tripping the display
+             */
+            struct PowerOnAttempt
+            {
+                /// @brief time at which power-on has been requested
+                uint32_t start = 0;
+                /// @brief nr of performed power trips
+                uint8_t trips = 0;
+                /// @brief time in ms between restoring the display power and its first message, 0 if it did not boot
+                uint32_t boot_time = 0;
+                /// @brief time in ms between the request and the Idle state, 0 if it has not been reached
+                uint32_t idle_time = 0;
+                /// @brief true if the display did not boot within MAX_POWER_TRIP_COUNT power trips
+                bool failed = false;
+            };
+
             /**
              * @brief Power Switch wich reflects the power state of the coffee machine.
              * On/Off will change the hardware state of the machine using uart and the power tripping mechanism.
@@ -39,13 +60,13 @@ namespace esphome
                 void dump_config() override;
 
                 /**
-                 * @brief Sets the mainboard uart reference used by this power switch. The uart is used to fake power on and power off messages.
+                 * @brief Sets the mainboard bus arbiter used by this power switch. The bus is used to fake power on and power off messages.
                  *
-                 * @param uart uart reference
+                 * @param bus bus arbiter reference
                  */
-                void set_mainboard_uart(uart::UARTDevice *uart)
+                void set_bus(BusArbiter *bus)
                 {
-                    mainboard_uart_ = uart;
+                    bus_ = bus;
                 }
 
                 /**
@@ -91,15 +112,6 @@ namespace esphome
                     cleaning_ = cleaning;
                 }
 
-                /**
-                 * @brief Check if power switch is currently injecting commands
-                 * Used to block display messages during command injection
-                 */
-                bool is_injecting_commands() const
-                {
-                    return injecting_commands_;
-                }
-
                 /**
                  * @brief Sets the initial state reference on this power switch
                  *
@@ -111,13 +123,13 @@ namespace esphome
                 }
 
                 /**
-                 * @brief Sets the status sensor reference for detecting actual machine ON state
+                 * @brief Sets the snapshot reference for detecting actual machine ON state
                  *
-                 * @param status_sensor reference to the main status sensor
+                 * @param snapshot hub components decoded machine snapshot
                  */
-                void set_status_sensor(philips_status_sensor::StatusSensor *status_sensor)
+                void set_machine_snapshot(const MachineSnapshot *snapshot)
                 {
-                    status_sensor_ = status_sensor;
+                    snapshot_ = snapshot;
                 }
 
                 /**
@@ -130,14 +142,57 @@ namespace esphome
                     power_message_repetitions_ = count;
                 }
 
+                /**
+                 * @brief The most recent power-on attempt
+                 *
+                 * @return attempt, nullptr if no attempt has been made yet
+                 */
+                const PowerOnAttempt *last_power_on_attempt() const
+                {
+                    if (history_count_ == 0)
+                        return nullptr;
+                    return &history_[(history_head_ + history_count_ - 1) % POWER_ON_HISTORY_SIZE];
+                }
+
+                /**
+                 * @brief Number of failed attempts within the last POWER_ON_HISTORY_SIZE power-on attempts
+                 */
+                uint8_t failed_power_on_attempts() const;
+
                 /**
                  * @brief Processes and publish the new switch state.
+                 * Only called when the power state of the machine changes.
                  */
                 void update_state(bool state);
 
             private:
-                /// @brief Reference to uart which is connected to the mainboard
-                uart::UARTDevice *mainboard_uart_;
+                /**
+                 * @brief Writes one burst of pre-power-on and power-on messages to the mainboard
+                 *
+                 * @param cleaning true if the machine should clean during startup
+                 */
+                void send_power_on_commands(bool cleaning);
+
+                /**
+                 * @brief Records a new power-on attempt, replacing the oldest one if the history is full
+                 */
+                void begin_power_on_attempt();
+
+                /**
+                 * @brief Stops updating the current power-on attempt and logs its outcome
+                 */
+                void finish_power_on_attempt();
+
+                /**
+                 * @brief The power-on attempt which is currently recorded
+                 */
+                PowerOnAttempt &current_power_on_attempt()
+                {
+                    return history_[(history_head_ + history_count_ - 1) % POWER_ON_HISTORY_SIZE];
+                }
+
+                /// @brief Arbiter of the mainboard bus
+                BusArbiter *bus_;
                 /// @brief power pin which is used for display power
                 GPIOPin *power_pin_;
                 /// @brief True if the coffee machine is supposed to clean
@@ -162,18 +217,38 @@ namespace esphome
                 uint power_message_repetitions_ = 5;
                 /// @brief End time of grace period after power-on (prevents premature OFF detection)
                 uint32_t power_on_grace_period_end_ = 0;
+                /// @brief power state most recently reported by the hub, applied after the grace period if it has been ignored
+                bool reported_state_ = false;
                 /// @brief Indicates if power-on commands are pending after power trip
                 bool pending_power_on_commands_ = false;
                 /// @brief Stores cleaning preference for pending power-on
                 bool cleaning_pending_ = true;
-                /// @brief Tracks if currently injecting power commands (blocks display messages)
-                bool injecting_commands_ = false;
-                /// @brief Timestamp when we should send pending power-on commands (after display boots)
+                /// @brief Time at which the display power has been restored after the first power trip
+                uint32_t power_restored_at_ = 0;
+                /// @brief Time of the last display message when the display power has been restored
+                uint32_t display_frame_at_restore_ = 0;
+                /// @brief Latest time to send pending power-on commands if the display does not boot
                 uint32_t send_commands_at_ = 0;
+                /// @brief True while the power-on command sequence is running (holds the bus, blocks display messages)
+                bool power_on_sequence_active_ = false;
+                /// @brief nr of power-on command bursts sent in the current sequence
+                uint8_t power_on_attempt_ = 0;
+                /// @brief Time at which the current power-on sequence step started
+                uint32_t power_on_step_start_ = 0;
+                /// @brief Delay until the next power-on sequence step
+                uint32_t power_on_step_delay_ = 0;
                 /// @brief initial power state reference
                 bool *initial_state_;
-                /// @brief Status sensor reference for detecting actual machine ON state
-                philips_status_sensor::StatusSensor *status_sensor_ = nullptr;
+                /// @brief the last POWER_ON_HISTORY_SIZE power-on attempts, oldest first
+                PowerOnAttempt history_[POWER_ON_HISTORY_SIZE];
+                /// @brief index of the oldest power-on attempt
+                uint8_t history_head_ = 0;
+                /// @brief nr of recorded power-on attempts
+                uint8_t history_count_ = 0;
+                /// @brief true while the outcome of the current power-on attempt is being recorded
+                bool power_on_attempt_active_ = false;
+                /// @brief decoded machine snapshot for detecting actual machine ON state
+                const MachineSnapshot *snapshot_ = nullptr;
             };
 
         } // namespace philips_power_switch
@@ -2,13 +2,8 @@
 
 #include "esphome/core/component.h"
 #include "esphome/components/text_sensor/text_sensor.h"
-#include "esphome/components/uart/uart.h"
-#include "../commands.h"
 #include "../localization.h"
-
-// Feel free to lower this, you might get some invalid intermittent state though
-#define REPEAT_REQUIREMENT 60
-#define BLINK_THRESHOLD 750
+#include "../machine_snapshot.h"
 
 namespace esphome
 {
@@ -27,61 +22,22 @@ namespace esphome
                 void dump_config() override;
 
                 /**
-                 * @brief Updates the status of this sensor based on the messages sent by the mainboard
-                 * @param data incoming data from the motherboard (19 bytes)
-                 */
-                void update_status(uint8_t *data);
-
-                /**
-                 * @brief Sets the status to Off
-                 */
-                void set_state_off()
-                {
-                    if (state != state_off)
-                        publish_state(state_off);
-                };
-
-                /**
-                 * @brief Published the state if it's different form the currently published state.
-                 *
+                 * @brief Publishes the state of a decoded mainboard message if it differs from the published state
+                 * @param snapshot decoded mainboard message
                  */
-                void update_state(const std::string &state)
+                void update_status(const MachineSnapshot &snapshot)
                 {
-                    if (state == new_state_)
-                    {
-                        if (new_state_counter_ >= REPEAT_REQUIREMENT)
-                        {
-                            if (this->state != state)
-                                publish_state(state);
-                        }
-                        else
-                        {
-                            new_state_counter_++;
-                        }
-                    }
-                    else
+                    if (snapshot.state != MachineState::UNKNOWN && snapshot.state != machine_state_)
                     {
-                        new_state_counter_ = 0;
-                        new_state_ = state;
+                        machine_state_ = snapshot.state;
+                        publish_state(state_text(machine_state_));
                     }
                 }
 
             private:
-                /// @brief counter which count how often a message has been seen
-                int new_state_counter_ = 0;
-
-                /// @brief cache for counting new messages
-                std::string new_state_ = state_unknown;
-
-                /// @brief status of the play/pause led
-                bool play_pause_led_ = false;
-
-                /// @brief time of play/pause change
-                uint32_t play_pause_last_change_ = 0;
-
-                /// @brief time of the last enable size led change
-                uint32_t show_size_led_last_change_ = 0;
+                /// @brief currently published state
+                MachineState machine_state_ = MachineState::UNKNOWN;
             };
         } // namespace philips_status_sensor
     }     // namespace philips_coffee_machine
-} // namespace esphome
\ No newline at end of file
+} // namespace esphome
@@ -0,0 +1,232 @@
+// Runs the bridge task on a thread: checks the handoff through the SpscRing and the forwarding between fake uarts.
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "bridge.h"
+#include "esphome/core/hal.h"
+#include "test_helpers.h"
+
+// Number of frames pushed through the ring by the producer thread
+#define RING_FRAMES 200000
+
+// Longest time the test waits for the bridge thread
+#define WAIT_TIMEOUT_MS 2000
+
+using namespace esphome::philips_coffee_machine;
+using esphome::uart::UARTComponent;
+using esphome::uart::UARTDevice;
+
+/**
+ * @brief Waits until a condition holds or WAIT_TIMEOUT_MS has passed
+ *
+ * @return true if the condition holds
+ */
+static bool wait_for(const std::function<bool()> &condition)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(WAIT_TIMEOUT_MS);
+    while (!condition())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/**
+ * @brief Mainboard message with the given led bytes and a valid checksum
+ */
+static std::vector<uint8_t> mainboard_message(uint8_t led)
+{
+    std::vector<uint8_t> message(MAINBOARD_FRAME_SIZE, led);
+    message[0] = message_header[0];
+    message[1] = message_header[1];
+    uint16_t crc = compute_crc(message.data(), MAINBOARD_FRAME_SIZE - CHECKSUM_SIZE);
+    message[MAINBOARD_FRAME_SIZE - 2] = checksum_low(crc);
+    message[MAINBOARD_FRAME_SIZE - 1] = checksum_high(crc);
+    return message;
+}
+
+/**
+ * @brief Splits the bytes written to the mainboard into display messages and checks that each of them is complete
+ */
+static std::vector<Command> split_commands(const std::vector<uint8_t> &written)
+{
+    std::vector<Command> commands;
+    CHECK(written.size() % DISPLAY_FRAME_SIZE == 0, "%zu bytes are not a whole number of messages", written.size());
+    for (std::size_t offset = 0; offset + DISPLAY_FRAME_SIZE <= written.size(); offset += DISPLAY_FRAME_SIZE)
+    {
+        Command command;
+        std::copy(written.begin() + offset, written.begin() + offset + DISPLAY_FRAME_SIZE, command.begin());
+        CHECK(command[0] == message_header[0] && command[1] == message_header[1] && is_valid_frame(command.data(), DISPLAY_FRAME_SIZE),
+              "torn message at byte %zu", offset);
+        commands.push_back(command);
+    }
+    return commands;
+}
+
+/**
+ * @brief A producer thread pushes numbered frames while the consumer pops them.
+ * Frames have to arrive in order, and a push must never fail while the ring has room.
+ */
+static void test_spsc_ring()
+{
+    SpscRing<MainboardFrame, FRAME_RING_SIZE> ring;
+    std::size_t rejected_with_room = 0;
+
+    std::thread producer([&ring, &rejected_with_room]() {
+        for (uint32_t i = 0; i < RING_FRAMES;)
+        {
+            MainboardFrame frame = {};
+            for (std::size_t byte = 0; byte < sizeof(i); byte++)
+                frame[byte] = (uint8_t)(i >> (8 * byte));
+            frame[MAINBOARD_FRAME_SIZE - 1] = (uint8_t)~i;
+
+            // The consumer only makes room, a ring which had room before the push must accept the frame
+            bool had_room = ring.size() < FRAME_RING_SIZE;
+            if (ring.push(frame))
+                i++;
+            else if (had_room)
+                rejected_with_room++;
+            else
+                std::this_thread::yield();
+        }
+    });
+
+    uint32_t expected = 0;
+    std::size_t out_of_order = 0;
+    while (expected < RING_FRAMES)
+    {
+        MainboardFrame frame;
+        if (!ring.pop(frame))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        uint32_t value = 0;
+        for (std::size_t byte = 0; byte < sizeof(value); byte++)
+            value |= (uint32_t)frame[byte] << (8 * byte);
+        if (value != expected || frame[MAINBOARD_FRAME_SIZE - 1] != (uint8_t)~expected)
+            out_of_order++;
+        expected = value + 1;
+    }
+    producer.join();
+
+    CHECK(out_of_order == 0, "%zu frames arrived out of order or torn", out_of_order);
+    CHECK(rejected_with_room == 0, "%zu frames were rejected although the ring had room", rejected_with_room);
+    CHECK(ring.size() == 0, "%zu frames left in the ring", ring.size());
+}
+
+/**
+ * @brief Starts the bridge task on fake uarts and checks forwarding in both directions,
+ * including frames injected by the component loop while the task forwards display messages.
+ */
+static void test_bridge_task()
+{
+    UARTComponent display_bus;
+    UARTComponent mainboard_bus;
+    UARTDevice display(&display_bus);
+    UARTDevice mainboard(&mainboard_bus);
+    BusArbiter bus;
+    Bridge bridge;
+    bus.set_mainboard_uart(&mainboard);
+    bridge.setup(&display, &mainboard, &bus);
+
+    CHECK(bridge.start_task(), "the bridge task could not be started");
+    CHECK(bridge.is_task_running(), "the bridge task is not running");
+
+    // Display messages reach the mainboard unchanged
+    std::vector<uint8_t> requests;
+    for (int i = 0; i < 20; i++)
+        requests.insert(requests.end(), command_status_request.begin(), command_status_request.end());
+    display_bus.receive(requests);
+    std::vector<uint8_t> to_mainboard;
+    CHECK(wait_for([&]() {
+              std::vector<uint8_t> written = mainboard_bus.take_written();
+              to_mainboard.insert(to_mainboard.end(), written.begin(), written.end());
+              return to_mainboard.size() >= requests.size();
+          }),
+          "only %zu of %zu bytes have been forwarded to the mainboard", to_mainboard.size(), requests.size());
+    CHECK(to_mainboard == requests, "the display messages have been changed");
+
+    // Mainboard messages reach the display and are handed to the component loop in order
+    std::vector<uint8_t> replies;
+    for (uint8_t led = 0; led < FRAME_RING_SIZE; led++)
+    {
+        std::vector<uint8_t> message = mainboard_message(led);
+        replies.insert(replies.end(), message.begin(), message.end());
+    }
+    mainboard_bus.receive(replies);
+    std::vector<MainboardFrame> popped;
+    CHECK(wait_for([&]() {
+              MainboardFrame frame;
+              while (bridge.pop_frame(frame))
+                  popped.push_back(frame);
+              return popped.size() >= FRAME_RING_SIZE;
+          }),
+          "only %zu of %d messages have been handed to the component loop", popped.size(), FRAME_RING_SIZE);
+    for (std::size_t i = 0; i < popped.size(); i++)
+        CHECK(popped[i][LED_OFFSET] == i, "message %zu arrived as message %d", i, popped[i][LED_OFFSET]);
+    CHECK(display_bus.take_written() == replies, "the mainboard messages have not been forwarded to the display");
+
+    // Frames injected by the component loop are written by the task between whole display messages
+    std::size_t injected = 0;
+    std::size_t forwarded = 0;
+    to_mainboard.clear();
+    for (int round = 0; round < 200; round++)
+    {
+        display_bus.receive(std::vector<uint8_t>(command_status_request.begin(), command_status_request.end()));
+        forwarded++;
+        // Only inject while the queue has room, the task drains it at its own pace
+        if (bus.queue_depth() < TX_QUEUE_SIZE && bus.enqueue(command_press_play_pause, TX_PRIORITY_ACTION))
+            injected++;
+        bus.loop();
+        std::vector<uint8_t> written = mainboard_bus.take_written();
+        to_mainboard.insert(to_mainboard.end(), written.begin(), written.end());
+    }
+    CHECK(wait_for([&]() {
+              bus.loop();
+              std::vector<uint8_t> written = mainboard_bus.take_written();
+              to_mainboard.insert(to_mainboard.end(), written.begin(), written.end());
+              return bus.queue_depth() == 0 && to_mainboard.size() >= (forwarded + injected) * DISPLAY_FRAME_SIZE;
+          }),
+          "only %zu of %zu messages have been written to the mainboard", to_mainboard.size() / DISPLAY_FRAME_SIZE, forwarded + injected);
+
+    std::size_t presses = 0;
+    std::size_t status_requests = 0;
+    for (const Command &command : split_commands(to_mainboard))
+    {
+        if (commands_equal(command, command_press_play_pause))
+            presses++;
+        else if (commands_equal(command, command_status_request))
+            status_requests++;
+    }
+    CHECK(presses == injected, "%zu of %zu injected messages have been written", presses, injected);
+    CHECK(status_requests == forwarded, "%zu of %zu display messages have been forwarded", status_requests, forwarded);
+
+    bridge.stop_task();
+    CHECK(!bridge.is_task_running(), "the bridge task is still running");
+
+    // Once the task has stopped the component loop writes the frames itself
+    bus.enqueue(command_press_size, TX_PRIORITY_ACTION);
+    bus.loop();
+    std::vector<uint8_t> written = mainboard_bus.take_written();
+    CHECK(written == std::vector<uint8_t>(command_press_size.begin(), command_press_size.end()), "the message has not been written after stopping the task");
+}
+
+int main()
+{
+    test_spsc_ring();
+    test_bridge_task();
+
+    if (test_failures != 0)
+    {
+        std::printf("%d checks failed\n", test_failures);
+        return 1;
+    }
+    return 0;
+}
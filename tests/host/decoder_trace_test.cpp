@@ -0,0 +1,250 @@
+// Replays mainboard traces through the MachineDecoder and checks the publish latency of every state class.
+// The latency is compared with the former debounce, which published a state after it had been decoded 60 times in a row.
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "checksum.h"
+#include "machine_decoder.h"
+#include "test_helpers.h"
+
+// Number of repetitions the former debounce required
+#define REPEAT_REQUIREMENT 60
+
+// Time at which a trace starts, the led tracker treats time 0 as "never"
+#define TRACE_START 1000
+
+using namespace esphome::philips_coffee_machine;
+
+/**
+ * @brief Part of a trace during which the mainboard sends the same message, or alternates between two messages
+ */
+struct Segment
+{
+    /// @brief length of the segment in ms
+    uint32_t duration;
+    /// @brief state which has to be published during the segment
+    MachineState expected;
+    /// @brief mainboard messages, the second one is only used by blinking segments
+    std::vector<std::vector<uint8_t>> frames;
+};
+
+/**
+ * @brief Mainboard trace as read from a .trace file
+ */
+struct Trace
+{
+    std::string name;
+    uint32_t frame_period = 0;
+    uint32_t blink_half_period = 0;
+    std::vector<Segment> segments;
+};
+
+/**
+ * @brief Debounce of the former status sensor: a state is published once it has been decoded
+ * REPEAT_REQUIREMENT times after its first occurrence. Frames without a known state are ignored.
+ */
+class RepeatDebounce
+{
+public:
+    bool update(MachineState state)
+    {
+        if (state != new_state_)
+        {
+            new_state_ = state;
+            counter_ = 0;
+            return false;
+        }
+        if (counter_ < REPEAT_REQUIREMENT)
+        {
+            counter_++;
+            return false;
+        }
+        if (state == this->state)
+            return false;
+        this->state = state;
+        return true;
+    }
+
+    MachineState state = MachineState::UNKNOWN;
+
+private:
+    MachineState new_state_ = MachineState::UNKNOWN;
+    int counter_ = 0;
+};
+
+/**
+ * @brief Latency of a published state, measured from the start of its segment
+ */
+struct Publish
+{
+    MachineState state;
+    uint32_t latency;
+};
+
+/**
+ * @brief Default settle time of a state class
+ */
+static uint32_t settle_time_of(StateClass state_class)
+{
+    switch (state_class)
+    {
+    case STATE_CLASS_ERROR:
+        return SETTLE_TIME_ERROR;
+    case STATE_CLASS_STEADY:
+        return SETTLE_TIME_STEADY;
+    default:
+        return SETTLE_TIME_SELECTION;
+    }
+}
+
+static bool load_trace(const std::string &path, Trace &trace)
+{
+    std::ifstream file(path);
+    if (!file)
+        return false;
+
+    trace.name = path.substr(path.find_last_of('/') + 1);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream fields(line);
+        std::string first;
+        fields >> first;
+        if (first == "frame_period")
+        {
+            fields >> trace.frame_period;
+            continue;
+        }
+        if (first == "blink_half_period")
+        {
+            fields >> trace.blink_half_period;
+            continue;
+        }
+
+        Segment segment;
+        std::string state;
+        segment.duration = std::stoul(first);
+        fields >> state;
+        CHECK(parse_state(state.c_str(), segment.expected), "%s: unknown state %s", trace.name.c_str(), state.c_str());
+
+        std::vector<uint8_t> frame;
+        std::string byte;
+        while (fields >> byte)
+        {
+            frame.push_back((uint8_t)std::stoul(byte, nullptr, 16));
+            if (frame.size() == MAINBOARD_FRAME_SIZE)
+            {
+                CHECK(is_valid_frame(frame.data(), frame.size()), "%s: invalid checksum in segment %zu", trace.name.c_str(), trace.segments.size());
+                segment.frames.push_back(frame);
+                frame.clear();
+            }
+        }
+        CHECK(frame.empty() && !segment.frames.empty(), "%s: incomplete message in segment %zu", trace.name.c_str(), trace.segments.size());
+        trace.segments.push_back(segment);
+    }
+    return trace.frame_period != 0 && trace.blink_half_period != 0;
+}
+
+static void replay(const Trace &trace, std::vector<Publish> &after, std::vector<Publish> &before)
+{
+    MachineDecoder decoder;
+    RepeatDebounce repeat;
+    MachineState published = decoder.snapshot().state;
+    MachineState run_state = MachineState::UNKNOWN;
+    uint32_t run_start = 0;
+
+    uint32_t now = TRACE_START;
+    for (const Segment &segment : trace.segments)
+    {
+        uint32_t segment_start = now;
+        for (; now - segment_start < segment.duration; now += trace.frame_period)
+        {
+            std::size_t phase = ((now - segment_start) / trace.blink_half_period) % segment.frames.size();
+            const MachineSnapshot &snapshot = decoder.decode(segment.frames[phase].data(), now);
+
+            if (snapshot.frame_state != run_state)
+            {
+                run_state = snapshot.frame_state;
+                run_start = now;
+            }
+
+            if (snapshot.state != published)
+            {
+                published = snapshot.state;
+                CHECK(published == segment.expected, "%s: published %s at %u ms during %s", trace.name.c_str(), state_name(published), now - TRACE_START,
+                      state_name(segment.expected));
+
+                // Off is published on the first message with all leds turned off, the others once they have settled
+                uint32_t settle_time = published == MachineState::OFF ? 0 : settle_time_of(state_class(published));
+                CHECK(now - run_start >= settle_time && now - run_start < settle_time + trace.frame_period, "%s: %s published after %u ms, settle time %u ms",
+                      trace.name.c_str(), state_name(published), now - run_start, settle_time);
+                after.push_back({published, now - segment_start});
+            }
+
+            if (snapshot.frame_state != MachineState::UNKNOWN && snapshot.frame_state != MachineState::OFF && repeat.update(snapshot.frame_state))
+                before.push_back({repeat.state, now - segment_start});
+        }
+
+        CHECK(published == segment.expected, "%s: %s has not been published during its segment", trace.name.c_str(), state_name(segment.expected));
+    }
+}
+
+int main()
+{
+    static const char *const traces[] = {"power_on.trace", "water_empty.trace", "dimmed_blink.trace"};
+
+    for (const char *name : traces)
+    {
+        Trace trace;
+        bool loaded = load_trace(std::string(TRACE_DIR) + "/" + name, trace);
+        CHECK(loaded, "%s: could not read the trace", name);
+        if (!loaded)
+            continue;
+
+        std::vector<Publish> after;
+        std::vector<Publish> before;
+        replay(trace, after, before);
+
+        std::printf("%s (message every %u ms)\n", trace.name.c_str(), trace.frame_period);
+        std::size_t next_before = 0;
+        std::printf("  %-28s %-10s %10s %10s\n", "state", "class", "after", "before");
+        for (const Publish &publish : after)
+        {
+            const char *class_name = "-";
+            if (publish.state != MachineState::OFF)
+                class_name = state_class(publish.state) == STATE_CLASS_ERROR ? "error" : state_class(publish.state) == STATE_CLASS_STEADY ? "steady" : "selection";
+
+            // The former debounce did not decode Off, it was set once the display fell silent
+            const Publish *previous = nullptr;
+            if (publish.state != MachineState::OFF && next_before < before.size())
+            {
+                previous = &before[next_before++];
+                CHECK(previous->state == publish.state, "%s: the former debounce published %s instead of %s", trace.name.c_str(), state_name(previous->state),
+                      state_name(publish.state));
+            }
+
+            if (previous == nullptr)
+            {
+                std::printf("  %-28s %-10s %8u ms %10s\n", state_name(publish.state), class_name, publish.latency, "-");
+                continue;
+            }
+
+            std::printf("  %-28s %-10s %8u ms %7u ms\n", state_name(publish.state), class_name, publish.latency, previous->latency);
+            CHECK(publish.latency < previous->latency, "%s: %s is published after %u ms instead of %u ms", trace.name.c_str(), state_name(publish.state), publish.latency,
+                  previous->latency);
+        }
+    }
+
+    if (test_failures != 0)
+    {
+        std::printf("%d checks failed\n", test_failures);
+        return 1;
+    }
+    return 0;
+}
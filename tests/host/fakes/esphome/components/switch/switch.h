@@ -0,0 +1,27 @@
+#pragma once
+
+#include "esphome/core/component.h"
+
+// Host stand-in for the ESPHome switch, published states are kept in state
+namespace esphome
+{
+    namespace switch_
+    {
+        class Switch
+        {
+        public:
+            virtual ~Switch() = default;
+
+            void publish_state(bool state)
+            {
+                this->state = state;
+            }
+
+            bool state = false;
+
+        protected:
+            virtual void write_state(bool state) = 0;
+        };
+
+    } // namespace switch_
+} // namespace esphome
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+
+// Host stand-in for the ESPHome uart, the tests feed the received bytes and inspect the written ones
+namespace esphome
+{
+    namespace uart
+    {
+        enum UARTParityOptions
+        {
+            UART_CONFIG_PARITY_NONE,
+        };
+
+        /**
+         * @brief Fake uart bus. Received and written bytes are kept in buffers which may be accessed from
+         * another thread than the one using the device.
+         */
+        class UARTComponent
+        {
+        public:
+            /**
+             * @brief Makes bytes available for reading
+             */
+            void receive(const std::vector<uint8_t> &data)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                rx_.insert(rx_.end(), data.begin(), data.end());
+            }
+
+            /**
+             * @brief Takes all bytes which have been written so far
+             */
+            std::vector<uint8_t> take_written()
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                std::vector<uint8_t> written;
+                written.swap(tx_);
+                return written;
+            }
+
+            int available()
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return (int) rx_.size();
+            }
+
+            bool read_array(uint8_t *data, std::size_t length)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (rx_.size() < length)
+                    return false;
+                for (std::size_t i = 0; i < length; i++)
+                {
+                    data[i] = rx_.front();
+                    rx_.pop_front();
+                }
+                return true;
+            }
+
+            void write_array(const uint8_t *data, std::size_t length)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                tx_.insert(tx_.end(), data, data + length);
+            }
+
+        private:
+            std::mutex mutex_;
+            std::deque<uint8_t> rx_;
+            std::vector<uint8_t> tx_;
+        };
+
+        /**
+         * @brief Device on a fake uart bus, forwards every call to its bus like the ESPHome device does
+         */
+        class UARTDevice
+        {
+        public:
+            UARTDevice() = default;
+            UARTDevice(UARTComponent *parent) : parent_(parent) {}
+
+            int available()
+            {
+                return parent_->available();
+            }
+
+            bool read_array(uint8_t *data, std::size_t length)
+            {
+                return parent_->read_array(data, length);
+            }
+
+            void write_array(const uint8_t *data, std::size_t length)
+            {
+                parent_->write_array(data, length);
+            }
+
+            template <std::size_t N>
+            void write_array(const std::array<uint8_t, N> &data)
+            {
+                parent_->write_array(data.data(), N);
+            }
+
+            void flush()
+            {
+            }
+
+            void check_uart_settings(uint32_t baud_rate, uint8_t stop_bits = 1, UARTParityOptions parity = UART_CONFIG_PARITY_NONE, uint8_t data_bits = 8)
+            {
+            }
+
+        protected:
+            UARTComponent *parent_ = nullptr;
+        };
+
+    } // namespace uart
+} // namespace esphome
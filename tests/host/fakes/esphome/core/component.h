@@ -0,0 +1,26 @@
+#pragma once
+
+#include "esphome/core/hal.h"
+
+// Host stand-in for the ESPHome component base, the tests call setup() and loop() themselves
+namespace esphome
+{
+    class Component
+    {
+    public:
+        virtual ~Component() = default;
+
+        virtual void setup()
+        {
+        }
+
+        virtual void loop()
+        {
+        }
+
+        virtual void dump_config()
+        {
+        }
+    };
+
+} // namespace esphome
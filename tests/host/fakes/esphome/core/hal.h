@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+
+// Host stand-in for the ESPHome hal, the time is controlled by the tests
+namespace esphome
+{
+    uint32_t millis();
+    uint32_t micros();
+    void delay(uint32_t ms);
+
+    /**
+     * @brief Output pin, records the last written level
+     */
+    class GPIOPin
+    {
+    public:
+        virtual ~GPIOPin() = default;
+
+        virtual void digital_write(bool value)
+        {
+            level = value;
+        }
+
+        bool level = false;
+    };
+
+    /**
+     * @brief Sets the time returned by millis()
+     *
+     * @param now time in ms
+     */
+    void set_fake_millis(uint32_t now);
+
+    /**
+     * @brief Advances the time returned by millis()
+     *
+     * @param ms time in ms
+     */
+    void advance_fake_millis(uint32_t ms);
+
+} // namespace esphome
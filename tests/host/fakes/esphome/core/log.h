@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdio>
+
+// Host stand-in for the ESPHome logger, messages up to debug level are printed
+#define ESP_HOST_LOG(level, tag, format, ...) std::printf("[%s][%s] " format "\n", level, tag, ##__VA_ARGS__)
+#define ESP_LOGE(tag, format, ...) ESP_HOST_LOG("E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) ESP_HOST_LOG("W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) ESP_HOST_LOG("I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) ESP_HOST_LOG("D", tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) ((void) (tag))
+#define ESP_LOGVV(tag, format, ...) ((void) (tag))
+#define ESP_LOGCONFIG(tag, format, ...) ESP_HOST_LOG("C", tag, format, ##__VA_ARGS__)
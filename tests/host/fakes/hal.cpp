@@ -0,0 +1,35 @@
+#include <atomic>
+
+#include "esphome/core/hal.h"
+
+namespace esphome
+{
+    /// @brief fake time in ms, read by the bridge thread as well
+    static std::atomic<uint32_t> fake_millis{1000};
+
+    uint32_t millis()
+    {
+        return fake_millis.load();
+    }
+
+    uint32_t micros()
+    {
+        return fake_millis.load() * 1000;
+    }
+
+    void delay(uint32_t ms)
+    {
+        fake_millis += ms;
+    }
+
+    void set_fake_millis(uint32_t now)
+    {
+        fake_millis.store(now);
+    }
+
+    void advance_fake_millis(uint32_t ms)
+    {
+        fake_millis += ms;
+    }
+
+} // namespace esphome
@@ -0,0 +1,224 @@
+// Runs the power-on sequence after a power trip against a simulated display and mainboard.
+// Checks that the bridge keeps forwarding messages while Power::loop() sequences the bursts, and that the bursts never overlap.
+
+#include <cstdio>
+#include <vector>
+#include "bridge.h"
+#include "esphome/core/hal.h"
+#include "switch/power.h"
+#include "test_helpers.h"
+
+// Time the simulated display needs to send its first message after its power has been restored
+#define DISPLAY_BOOT_TIME 300
+
+// Time between two messages of the simulated display
+#define DISPLAY_REQUEST_PERIOD 30
+
+// Length of a simulated power-on
+#define SIMULATION_TIME 6000
+
+// Time the bus may additionally be held for sending the bursts
+#define BURST_MARGIN 100
+
+using namespace esphome;
+using namespace esphome::philips_coffee_machine;
+using esphome::uart::UARTComponent;
+using esphome::uart::UARTDevice;
+
+/**
+ * @brief Message of an idle machine, sent by the simulated mainboard in reply to every message it receives
+ */
+static const uint8_t idle_message[MAINBOARD_FRAME_SIZE] = {0xD5, 0x55, 0x00, 0x07, 0x07, 0x07, 0x07, 0x00, 0x00, 0x00,
+                                                           0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x2B};
+
+/**
+ * @brief Kind of a message written to the mainboard
+ */
+enum class Written
+{
+    STATUS_REQUEST,
+    PRE_POWER_ON,
+    POWER_ON,
+    OTHER,
+};
+
+/**
+ * @brief Message written to the mainboard and the time it has been written at
+ */
+struct WireMessage
+{
+    Written kind;
+    uint32_t time;
+};
+
+/**
+ * @brief Turns the machine on with a power trip and checks the traffic on both uarts
+ *
+ * @param repetitions configured power message repetitions
+ */
+static void run_power_on(uint16_t repetitions)
+{
+    UARTComponent display_bus;
+    UARTComponent mainboard_bus;
+    UARTDevice display(&display_bus);
+    UARTDevice mainboard(&mainboard_bus);
+    BusArbiter bus;
+    Bridge bridge;
+    bus.set_mainboard_uart(&mainboard);
+    bridge.setup(&display, &mainboard, &bus);
+
+    GPIOPin pin;
+    bool initial_state = false;
+    philips_power_switch::Power power;
+    power.set_bus(&bus);
+    power.set_power_pin(&pin);
+    power.set_initial_state(&initial_state);
+    power.set_power_message_repetitions(repetitions);
+    power.setup();
+
+    std::vector<uint8_t> to_mainboard;
+    std::vector<WireMessage> wire;
+    std::size_t requests = 0;
+    std::size_t requests_while_held = 0;
+    std::size_t replies = 0;
+    std::size_t stalled_polls = 0;
+    uint32_t acquired_at = 0;
+    uint32_t released_at = 0;
+    std::size_t power_messages_at_release = 0;
+    bool display_powered = true;
+    bool display_booted = false;
+    uint32_t display_restored_at = 0;
+    uint32_t next_request = 0;
+
+    power.write_state(true);
+
+    uint32_t start = millis();
+    while (millis() - start < SIMULATION_TIME)
+    {
+        advance_fake_millis(1);
+        uint32_t now = millis();
+
+        // The display is silent while its power is cut and boots once it has been restored
+        bool powered = pin.level == initial_state;
+        if (powered && !display_powered)
+            display_restored_at = now;
+        display_powered = powered;
+        if (display_restored_at != 0 && powered && !display_booted && now - display_restored_at >= DISPLAY_BOOT_TIME)
+        {
+            display_booted = true;
+            next_request = now;
+        }
+        bool held = bus.is_acquired();
+        if (display_booted && now >= next_request)
+        {
+            display_bus.receive(std::vector<uint8_t>(command_status_request.begin(), command_status_request.end()));
+            next_request = now + DISPLAY_REQUEST_PERIOD;
+            requests++;
+            if (held)
+                requests_while_held++;
+        }
+
+        // Component loop without a bridge task
+        bridge.poll();
+        if (display_bus.available() != 0)
+            stalled_polls++;
+        MainboardFrame frame;
+        while (bridge.pop_frame(frame))
+        {
+        }
+        power.loop();
+        bus.loop();
+
+        if (!held && bus.is_acquired())
+            acquired_at = now;
+        if (held && !bus.is_acquired())
+        {
+            released_at = now;
+            power_messages_at_release = wire.size();
+            CHECK(bus.queue_depth() == 0, "the bus has been released with %zu messages queued", bus.queue_depth());
+        }
+
+        // The simulated mainboard answers every complete message
+        std::vector<uint8_t> written = mainboard_bus.take_written();
+        to_mainboard.insert(to_mainboard.end(), written.begin(), written.end());
+        while (to_mainboard.size() >= DISPLAY_FRAME_SIZE)
+        {
+            Command command;
+            std::copy(to_mainboard.begin(), to_mainboard.begin() + DISPLAY_FRAME_SIZE, command.begin());
+            to_mainboard.erase(to_mainboard.begin(), to_mainboard.begin() + DISPLAY_FRAME_SIZE);
+            CHECK(is_valid_frame(command.data(), DISPLAY_FRAME_SIZE), "torn message written to the mainboard at %u ms", now - start);
+
+            Written kind = Written::OTHER;
+            if (commands_equal(command, command_status_request))
+                kind = Written::STATUS_REQUEST;
+            else if (commands_equal(command, command_pre_power_on))
+                kind = Written::PRE_POWER_ON;
+            else if (commands_equal(command, command_power_with_cleaning))
+                kind = Written::POWER_ON;
+            wire.push_back({kind, now});
+            mainboard_bus.receive(std::vector<uint8_t>(idle_message, idle_message + MAINBOARD_FRAME_SIZE));
+        }
+
+        replies += display_bus.take_written().size() / MAINBOARD_FRAME_SIZE;
+    }
+
+    std::printf("%u repetitions: bus held for %u ms, %zu of %zu display messages dropped, %zu answered from the cache\n", repetitions + 1,
+                released_at - acquired_at, requests_while_held, requests, (std::size_t)bridge.cached_replies());
+
+    CHECK(acquired_at != 0 && released_at != 0, "the power-on sequence has not completed");
+    CHECK(stalled_polls == 0, "display messages stayed unread during %zu polls", stalled_polls);
+    CHECK(bus.dropped_count() == 0, "%u messages did not fit into the queue", bus.dropped_count());
+
+    // Every display message outside the sequence reaches the mainboard, and the display receives at least one reply to each of its messages
+    std::size_t status_requests = 0;
+    std::size_t requests_after_release = 0;
+    for (const WireMessage &message : wire)
+    {
+        if (message.kind == Written::STATUS_REQUEST)
+        {
+            status_requests++;
+            if (message.time > released_at)
+                requests_after_release++;
+        }
+    }
+    CHECK(status_requests == requests - requests_while_held, "%zu of %zu display messages reached the mainboard", status_requests, requests - requests_while_held);
+    CHECK(requests_after_release > 0, "no display message has been forwarded after the sequence");
+    CHECK(replies + 1 >= requests, "the display received %zu messages in reply to %zu", replies, requests);
+
+    // Three bursts of pre-power-on and power-on messages, at least POWER_ON_ATTEMPT_DELAY apart
+    std::vector<WireMessage> power_messages;
+    for (std::size_t i = 0; i < power_messages_at_release; i++)
+    {
+        if (wire[i].kind != Written::STATUS_REQUEST)
+            power_messages.push_back(wire[i]);
+    }
+    std::size_t burst_length = 2 * (repetitions + 1);
+    CHECK(power_messages.size() == POWER_ON_ATTEMPTS * burst_length, "%zu of %zu power-on messages have been sent before the bus was released",
+          power_messages.size(), POWER_ON_ATTEMPTS * burst_length);
+    for (std::size_t i = 0; i < power_messages.size(); i++)
+    {
+        Written expected = i % burst_length <= repetitions ? Written::PRE_POWER_ON : Written::POWER_ON;
+        CHECK(power_messages[i].kind == expected, "power-on message %zu is out of order", i);
+        if (i > 0 && i % burst_length == 0)
+            CHECK(power_messages[i].time - power_messages[i - 1].time >= POWER_ON_ATTEMPT_DELAY, "burst %zu started %u ms after the previous one",
+                  i / burst_length, power_messages[i].time - power_messages[i - 1].time);
+    }
+    if (!power_messages.empty())
+        CHECK(released_at - power_messages.back().time >= POWER_ON_HOLD_DURATION, "the bus has been released %u ms after the last burst",
+              released_at - power_messages.back().time);
+    CHECK(released_at - acquired_at <= (POWER_ON_ATTEMPTS - 1) * POWER_ON_ATTEMPT_DELAY + POWER_ON_HOLD_DURATION + BURST_MARGIN,
+          "the bus has been held for %u ms", released_at - acquired_at);
+}
+
+int main()
+{
+    run_power_on(MESSAGE_REPETITIONS);
+    run_power_on(25);
+
+    if (test_failures != 0)
+    {
+        std::printf("%d checks failed\n", test_failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,195 @@
+// Compares the status rule table with the comparison chain it replaced, using random mainboard messages.
+
+#include <cstdio>
+#include <random>
+#include "status_rules.h"
+#include "test_helpers.h"
+
+// Number of random messages per qualifier combination
+#define RANDOM_MESSAGES 250000
+
+using namespace esphome::philips_coffee_machine;
+
+/**
+ * @brief Former StatusSensor::update_status() as a pure function
+ *
+ * @param data mainboard message (19 bytes)
+ * @param is_play_pause_blinking whether the play/pause led has changed recently
+ * @param show_size_changed_recently whether the size led has changed recently
+ * @return decoded state, UNKNOWN if the former chain did not update the state
+ */
+static MachineState decode_chain(const uint8_t *data, bool is_play_pause_blinking, bool show_size_changed_recently)
+{
+    bool play_pause_led = data[16] == led_on;
+
+    // Check for idle state (selection led on)
+#ifdef PHILIPS_EP3243
+    if (data[3] == led_on && data[4] == led_on && data[5] == led_on && data[13] == led_off && data[14] == led_off && data[15] == led_off)
+#else
+    if (data[3] == led_on && data[4] == led_on && data[5] == led_on && data[6] != led_off)
+#endif
+        return MachineState::IDLE;
+
+    // Check for rotating icons - pre heating
+    if (data[3] == led_half || data[4] == led_half || data[5] == led_half || data[6] == led_half)
+        return play_pause_led ? MachineState::CLEANING : MachineState::PREPARING;
+
+    // 3 warning lights indicate an internal error (i.e. overheating)
+    if (data[15] != led_off && data[14] == led_second)
+        return MachineState::INTERNAL_ERROR;
+
+    // Warning/Error led
+    if (data[15] == led_second)
+        return MachineState::ERROR;
+
+    // Water empty led
+    if (data[14] == led_second)
+        return MachineState::WATER_EMPTY;
+
+    // Waste container led
+    if (data[15] == led_on)
+        return MachineState::WASTE_WARNING;
+
+    // Coffee selected
+    if (data[3] == led_off && data[4] == led_off && (data[5] == led_on || data[5] == led_second) && data[6] == led_off)
+    {
+        if (!is_play_pause_blinking)
+            return (data[5] == led_on) ? MachineState::COFFEE_BREWING : MachineState::COFFEE_2X_BREWING;
+        if (data[9] == led_second)
+            return MachineState::GROUND_COFFEE_SELECTED;
+        if (data[11] == led_off && show_size_changed_recently)
+            return MachineState::COFFEE_PROGRAMMING_MODE;
+        return (data[5] == led_on) ? MachineState::COFFEE_SELECTED : MachineState::COFFEE_2X_SELECTED;
+    }
+
+    // Steam selected
+    if (data[3] == led_off && data[4] == led_off && data[5] == led_off && (data[6] == led_on || data[6] == led_third))
+    {
+#ifdef PHILIPS_EP2235
+        if (!is_play_pause_blinking)
+            return MachineState::CAPPUCCINO_BREWING;
+        if (data[9] == led_second)
+            return MachineState::GROUND_CAPPUCCINO_SELECTED;
+        if (data[11] == led_off && show_size_changed_recently)
+            return MachineState::CAPPUCCINO_PROGRAMMING_MODE;
+        return MachineState::CAPPUCCINO_SELECTED;
+#elif defined(PHILIPS_EP3243)
+        if (!is_play_pause_blinking)
+            return MachineState::LATTE_BREWING;
+        if (data[11] == led_off && show_size_changed_recently)
+            return MachineState::LATTE_PROGRAMMING_MODE;
+        return data[9] == led_second ? MachineState::GROUND_LATTE_SELECTED : MachineState::LATTE_SELECTED;
+#else
+        return is_play_pause_blinking ? MachineState::STEAM_SELECTED : MachineState::STEAM_BREWING;
+#endif
+    }
+
+    // Hot water selected
+#ifdef PHILIPS_EP3243
+    if (data[3] == led_off && data[4] == led_off && data[5] == led_off && data[6] == led_off && data[7] == led_second)
+#else
+    if (data[3] == led_off && data[4] == led_on && data[5] == led_off && data[6] == led_off)
+#endif
+    {
+        if (!is_play_pause_blinking)
+            return MachineState::HOT_WATER_BREWING;
+        if (data[11] == led_off && show_size_changed_recently)
+            return MachineState::HOT_WATER_PROGRAMMING_MODE;
+        return MachineState::HOT_WATER_SELECTED;
+    }
+
+    // Espresso selected
+    if ((data[3] == led_on || data[3] == led_second) && data[4] == led_off && data[5] == led_off && data[6] == led_off)
+    {
+        if (!is_play_pause_blinking)
+            return (data[3] == led_on) ? MachineState::ESPRESSO_BREWING : MachineState::ESPRESSO_2X_BREWING;
+        if (data[9] == led_second)
+            return MachineState::GROUND_ESPRESSO_SELECTED;
+        if (data[11] == led_off && show_size_changed_recently)
+            return MachineState::ESPRESSO_PROGRAMMING_MODE;
+        return (data[3] == led_on) ? MachineState::ESPRESSO_SELECTED : MachineState::ESPRESSO_2X_SELECTED;
+    }
+
+#ifdef PHILIPS_EP3243
+    // Cappuccino selected
+    if (data[3] == led_off && data[4] == led_on && data[5] == led_off && data[6] == led_off)
+    {
+        if (!is_play_pause_blinking)
+            return MachineState::CAPPUCCINO_BREWING;
+        if (data[11] == led_off && show_size_changed_recently)
+            return MachineState::CAPPUCCINO_PROGRAMMING_MODE;
+        return data[9] == led_second ? MachineState::GROUND_CAPPUCCINO_SELECTED : MachineState::CAPPUCCINO_SELECTED;
+    }
+
+    // Americano selected
+    if (data[3] == led_off && data[4] == led_off && data[5] == led_off && (data[6] == led_second || data[7] == led_on))
+    {
+        if (!is_play_pause_blinking)
+            return (data[6] == led_second) ? MachineState::AMERICANO_BREWING : MachineState::AMERICANO_2X_BREWING;
+        if (data[9] == led_second)
+            return MachineState::GROUND_AMERICANO_SELECTED;
+        if (data[11] == led_off && show_size_changed_recently)
+            return MachineState::AMERICANO_PROGRAMMING_MODE;
+        return (data[6] == led_second) ? MachineState::AMERICANO_SELECTED : MachineState::AMERICANO_2X_SELECTED;
+    }
+#endif
+
+    return MachineState::UNKNOWN;
+}
+
+int main()
+{
+    // Values a led byte can take, off is drawn more often so that the selection states are reached
+    static const uint8_t led_values[] = {led_off, led_off, led_off, led_off, led_half, led_on, led_on, led_second, led_third};
+
+    std::mt19937 random(0x5EED);
+    std::uniform_int_distribution<std::size_t> pick(0, sizeof(led_values) / sizeof(led_values[0]) - 1);
+
+    bool reached[(std::size_t)MachineState::STEAM_BREWING + 1] = {};
+    std::size_t mismatches = 0;
+
+    for (int combination = 0; combination < 4; combination++)
+    {
+        bool blinking = combination & 1;
+        bool size_changed = combination & 2;
+        uint8_t qualifiers = blinking ? QUALIFIER_BLINKING : QUALIFIER_STEADY;
+        if (size_changed)
+            qualifiers |= QUALIFIER_SIZE_CHANGED;
+
+        for (int i = 0; i < RANDOM_MESSAGES; i++)
+        {
+            uint8_t data[MAINBOARD_FRAME_SIZE] = {message_header[0], message_header[1]};
+            for (std::size_t led = LED_OFFSET; led < LED_OFFSET + LED_COUNT; led++)
+                data[led] = led_values[pick(random)];
+
+            MachineState expected = decode_chain(data, blinking, size_changed);
+            const StatusRule *rule = find_status_rule(load_led_words(data), qualifiers);
+            MachineState state = rule == nullptr ? MachineState::UNKNOWN : rule->state;
+            reached[(std::size_t)expected] = true;
+
+            if (state == expected)
+                continue;
+
+            // Only report the first few, a broken rule usually affects many messages
+            if (mismatches++ < 10)
+            {
+                std::printf("mismatch (blinking %d, size changed %d):", blinking, size_changed);
+                for (std::size_t led = LED_OFFSET; led < LED_OFFSET + LED_COUNT; led++)
+                    std::printf(" %02X", data[led]);
+                std::printf(": table %s, chain %s\n", state_name(state), state_name(expected));
+            }
+        }
+    }
+    CHECK(mismatches == 0, "%zu of %d messages decode differently", mismatches, 4 * RANDOM_MESSAGES);
+
+    // Every state of the table has to be covered by the random messages
+    for (std::size_t i = 0; i < STATUS_RULE_COUNT; i++)
+        CHECK(reached[(std::size_t)status_rules[i].state], "%s has not been reached", state_name(status_rules[i].state));
+
+    if (test_failures != 0)
+    {
+        std::printf("%d checks failed\n", test_failures);
+        return 1;
+    }
+    return 0;
+}
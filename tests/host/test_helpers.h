@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include "machine_state.h"
+
+/// @brief Reports a failed condition and counts it, the test fails if any check failed
+#define CHECK(condition, ...)                                                         \
+    do                                                                                \
+    {                                                                                 \
+        if (!(condition))                                                             \
+        {                                                                             \
+            std::printf("%s:%d: check failed: %s: ", __FILE__, __LINE__, #condition); \
+            std::printf(__VA_ARGS__);                                                 \
+            std::printf("\n");                                                        \
+            test_failures++;                                                          \
+        }                                                                             \
+    } while (0)
+
+namespace esphome
+{
+    namespace philips_coffee_machine
+    {
+        /// @brief number of failed checks
+        static int test_failures = 0;
+
+        /// @brief names of all machine states, in the order of MachineState
+        static const char *const state_names[] = {
+            "UNKNOWN",
+            "OFF",
+            "IDLE",
+            "CLEANING",
+            "PREPARING",
+            "WATER_EMPTY",
+            "WASTE_WARNING",
+            "ERROR",
+            "INTERNAL_ERROR",
+            "GROUND_COFFEE_SELECTED",
+            "COFFEE_PROGRAMMING_MODE",
+            "COFFEE_SELECTED",
+            "COFFEE_2X_SELECTED",
+            "COFFEE_BREWING",
+            "COFFEE_2X_BREWING",
+            "GROUND_ESPRESSO_SELECTED",
+            "ESPRESSO_PROGRAMMING_MODE",
+            "ESPRESSO_SELECTED",
+            "ESPRESSO_2X_SELECTED",
+            "ESPRESSO_BREWING",
+            "ESPRESSO_2X_BREWING",
+            "GROUND_AMERICANO_SELECTED",
+            "AMERICANO_PROGRAMMING_MODE",
+            "AMERICANO_SELECTED",
+            "AMERICANO_2X_SELECTED",
+            "AMERICANO_BREWING",
+            "AMERICANO_2X_BREWING",
+            "GROUND_CAPPUCCINO_SELECTED",
+            "CAPPUCCINO_PROGRAMMING_MODE",
+            "CAPPUCCINO_SELECTED",
+            "CAPPUCCINO_BREWING",
+            "GROUND_LATTE_SELECTED",
+            "LATTE_PROGRAMMING_MODE",
+            "LATTE_SELECTED",
+            "LATTE_BREWING",
+            "HOT_WATER_PROGRAMMING_MODE",
+            "HOT_WATER_SELECTED",
+            "HOT_WATER_BREWING",
+            "STEAM_SELECTED",
+            "STEAM_BREWING",
+        };
+
+        static_assert(sizeof(state_names) / sizeof(state_names[0]) == (std::size_t)MachineState::STEAM_BREWING + 1, "every state needs a name");
+
+        /**
+         * @brief Name of a state, as used in the traces
+         */
+        inline const char *state_name(MachineState state)
+        {
+            return state_names[(std::size_t)state];
+        }
+
+        /**
+         * @brief Looks up a state by its name
+         *
+         * @param name name of the state
+         * @param state receives the state
+         * @return true if the name is known
+         */
+        inline bool parse_state(const char *name, MachineState &state)
+        {
+            for (std::size_t i = 0; i < sizeof(state_names) / sizeof(state_names[0]); i++)
+            {
+                if (std::strcmp(name, state_names[i]) == 0)
+                {
+                    state = (MachineState)i;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    } // namespace philips_coffee_machine
+} // namespace esphome